@@ -0,0 +1,191 @@
+"""
+Performance regression suite: runs a fixed subset of instances with fixed seeds and a fixed
+iteration budget, and compares the results with a stored baseline.
+
+The gap to the reference objective and the number of iterations only depend on the seeds and the
+budget, so they are always checked. The iterations per second depend on the machine, so they are
+only checked with --speed, against a baseline saved by `update` on the same machine.
+
+    python3 scripts/regression.py check           # fails if the gap or the iterations changed
+    python3 scripts/regression.py check --speed   # also fails if the runs got slower
+    python3 scripts/regression.py update          # saves the current results as the new baseline
+"""
+
+from __future__ import annotations
+
+import argparse
+import csv
+import subprocess
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+BASELINE_FILE = ROOT / "scripts" / "regression_baseline.csv"
+
+# (instance, seed, extra options): the instances with up to 15 clients are solved exactly, so they are not included
+RUNS = [
+    ("Solomon/25/R101_1", 1, []),
+    ("Solomon/25/C101_2", 2, []),
+    ("Solomon/50/RC101_1.5", 3, []),
+    ("Solomon/50/R101_3", 4, []),
+    ("Solomon/100/C101_1", 5, []),
+    ("Solomon/100/R101_2", 6, []),
+    ("TSPLIB/eil51_0.5", 7, []),
+    ("TSPLIB/kroA100_2", 8, []),
+]
+# option combinations that crashed before, only checked to finish without errors, since the adaptive moves depend on
+# the measured times and so the results are not reproducible
+SMOKE_RUNS = [
+    ("Solomon/50/R101_3", 1, ["--adaptiveMoves", "--interMoves", "none"]),
+]
+IT_NI = 1000  # iterations without improvement to stop each run
+THREADS = 1  # the results do not depend on the threads, but the iterations per second do
+
+GAP_TOLERANCE = 0.5  # maximum increase of the gap, in percentage points
+SPEED_TOLERANCE = 0.25  # maximum relative decrease of the iterations per second, with --speed
+
+
+@dataclass
+class Result:
+    instance: str
+    seed: int
+    options: str
+    obj: int
+    gap: float  # to ref_obj, in %
+    iterations: int
+    its_per_sec: float
+    time_to_best: int  # ms
+
+    def label(self) -> str:
+        return "{} {}".format(self.instance, self.options).strip()
+
+
+# the reference objective of each instance, or its optimal value when it has no reference objective
+def reference_objectives() -> dict[str, int]:
+    refs = {}
+    with open(ROOT / "instances" / "reference_data.csv") as f:
+        for row in csv.DictReader(f):
+            if row["ref_obj"] or row["opt"]:
+                refs["{}/{}_{}".format(row["set"], row["name"], row["beta"])] = int(row["ref_obj"] or row["opt"])
+    return refs
+
+
+# the output lines of the run, as a dict from the first word to the rest of the line
+def execute(binary: Path, instance: str, seed: int, options: list[str]) -> dict[str, str]:
+    command = [
+        str(binary),
+        str(ROOT / "instances" / "{}.dat".format(instance)),
+        "--seed",
+        str(seed),
+        "--itNi",
+        str(IT_NI),
+        "--threads",
+        str(THREADS),
+        "--timeLimit",
+        "100000",
+        *options,
+    ]
+    output = subprocess.run(command, capture_output=True, text=True, check=True).stdout
+    return dict(line.split(" ", 1) for line in output.splitlines() if " " in line)
+
+
+def run(binary: Path, instance: str, seed: int, options: list[str], ref_obj: int) -> Result:
+    values = execute(binary, instance, seed, options)
+
+    obj = int(values["OBJ"])
+    iterations = int(values["ITERATIONS"])
+    exec_time = max(int(values["EXEC_TIME"]), 1)
+    return Result(
+        instance=instance,
+        seed=seed,
+        options=" ".join(options),
+        obj=obj,
+        gap=100 * obj / ref_obj - 100,
+        iterations=iterations,
+        its_per_sec=1000 * iterations / exec_time,
+        time_to_best=int(values["SOL_TIME"]),
+    )
+
+
+def run_all(binary: Path) -> list[Result]:
+    refs = reference_objectives()
+    results = []
+    for instance, seed, options in RUNS:
+        result = run(binary, instance, seed, options, refs[instance])
+        print(
+            "{:24s} obj {:7d}  gap {:6.2f}%  {:9.1f} it/s  best at {:6d} ms  {}".format(
+                instance, result.obj, result.gap, result.its_per_sec, result.time_to_best, result.options
+            ),
+            flush=True,
+        )
+        results.append(result)
+    return results
+
+
+def save_baseline(results: list[Result]):
+    with open(BASELINE_FILE, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["instance", "seed", "options", "obj", "gap", "iterations", "its_per_sec", "time_to_best"])
+        for r in results:
+            writer.writerow(
+                [r.instance, r.seed, r.options, r.obj, "{:.4f}".format(r.gap), r.iterations,
+                 "{:.1f}".format(r.its_per_sec), r.time_to_best]
+            )
+
+
+def load_baseline() -> dict[tuple[str, str], dict[str, str]]:
+    with open(BASELINE_FILE) as f:
+        return {(row["instance"], row["options"]): row for row in csv.DictReader(f)}
+
+
+def check(results: list[Result], speed: bool) -> bool:
+    baseline = load_baseline()
+    ok = True
+    for r in results:
+        base = baseline.get((r.instance, r.options))
+        if base is None:
+            print("{}: not in the baseline".format(r.label()))
+            ok = False
+            continue
+
+        if r.gap > float(base["gap"]) + GAP_TOLERANCE:
+            print("{}: gap {:.2f}% > baseline {}%".format(r.label(), r.gap, base["gap"]))
+            ok = False
+        if r.iterations != int(base["iterations"]):
+            print("{}: {} iterations != baseline {}".format(r.label(), r.iterations, base["iterations"]))
+            ok = False
+        if speed and r.its_per_sec < (1 - SPEED_TOLERANCE) * float(base["its_per_sec"]):
+            print("{}: {:.1f} it/s < baseline {} it/s".format(r.label(), r.its_per_sec, base["its_per_sec"]))
+            ok = False
+    return ok
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Performance regression suite of TSPrd.")
+    parser.add_argument("command", choices=["check", "update"])
+    parser.add_argument(
+        "--binary",
+        type=Path,
+        default=ROOT / "build" / "TSPrd",
+        help="TSPrd binary to be tested.",
+    )
+    parser.add_argument(
+        "--speed",
+        action="store_true",
+        help="Also check the iterations per second, only meaningful if the baseline was saved on this machine.",
+    )
+    args = parser.parse_args()
+
+    results = run_all(args.binary)
+    for instance, seed, options in SMOKE_RUNS:
+        execute(args.binary, instance, seed, options)
+    if args.command == "update":
+        save_baseline(results)
+        print("Baseline saved to {}".format(BASELINE_FILE))
+    elif not check(results, args.speed):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
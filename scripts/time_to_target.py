@@ -0,0 +1,87 @@
+"""
+Time-to-target comparison of configurations of TSPrd: runs each configuration on the same instances and
+seeds, follows the --progress stream of each run, and reports how many runs reached the target value
+and the median time they took to reach it.
+
+    python3 scripts/time_to_target.py --instances Solomon/100/R101_1 TSPLIB/a280_1 --seeds 5 \\
+        --config best= --config "first=--intraStrategy first"
+
+The target of an instance is its reference objective (or optimum) increased by --gap percent.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import math
+import statistics
+import subprocess
+import tempfile
+from pathlib import Path
+
+from regression import ROOT, reference_objectives
+
+
+# time in ms until the run found a solution with value at most `target`, None if it did not
+def time_to_target(binary: Path, instance: str, seed: int, options: list[str], time_limit: int, target: int):
+    with tempfile.NamedTemporaryFile(suffix=".jsonl") as progress:
+        command = [
+            str(binary),
+            str(ROOT / "instances" / "{}.dat".format(instance)),
+            "--seed",
+            str(seed),
+            "--timeLimit",
+            str(time_limit),
+            "--progress",
+            progress.name,
+            *options,
+        ]
+        subprocess.run(command, capture_output=True, text=True, check=True)
+        for line in Path(progress.name).read_text().splitlines():
+            improvement = json.loads(line)
+            if improvement["eval"] <= target:
+                return improvement["time"]
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Time-to-target comparison of configurations of TSPrd.")
+    parser.add_argument("--binary", type=Path, default=ROOT / "build" / "TSPrd", help="TSPrd binary.")
+    parser.add_argument("--instances", nargs="+", required=True, help="Instances, as Solomon/100/R101_1.")
+    parser.add_argument("--seeds", type=int, default=5, help="Number of seeds, from 1, of each instance.")
+    parser.add_argument("--gap", type=float, default=0.0, help="Target gap to the reference objective, in %%.")
+    parser.add_argument("--timeLimit", type=int, default=60, help="Time limit of each run, in seconds.")
+    parser.add_argument(
+        "--config",
+        action="append",
+        required=True,
+        help="Configuration as name=options, e.g. \"first=--intraStrategy first\".",
+    )
+    args = parser.parse_args()
+
+    refs = reference_objectives()
+    configs = [config.split("=", 1) for config in args.config]
+
+    print("{:24s} {:10s} {:>7s} {:>12s}".format("instance", "config", "reached", "median ms"))
+    for instance in args.instances:
+        target = math.floor(refs[instance] * (1 + args.gap / 100))
+        for name, options in configs:
+            times = [
+                time_to_target(args.binary, instance, seed, options.split(), args.timeLimit, target)
+                for seed in range(1, args.seeds + 1)
+            ]
+            # the runs that did not reach the target count as slower than any that did
+            median = statistics.median_low([t if t is not None else math.inf for t in times])
+            print(
+                "{:24s} {:10s} {:>7s} {:>12s}".format(
+                    instance,
+                    name,
+                    "{}/{}".format(sum(t is not None for t in times), len(times)),
+                    "-" if median == math.inf else str(median),
+                ),
+                flush=True,
+            )
+
+
+if __name__ == "__main__":
+    main()
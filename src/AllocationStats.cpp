@@ -0,0 +1,23 @@
+#include "AllocationStats.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef TSPRD_STATS
+// the other forms of new and delete of the standard library call these ones
+void* operator new(std::size_t size) {
+    AllocationStats::record(size);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
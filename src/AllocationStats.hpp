@@ -0,0 +1,106 @@
+#ifndef TSPRD_ALLOCATIONSTATS_H
+#define TSPRD_ALLOCATIONSTATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+/*
+ * Number of allocations and allocated bytes of each phase of the algorithm, printed by --stats
+ *
+ * the global operator new is replaced in AllocationStats.cpp, only in builds with TSPRD_STATS, and each allocation is
+ * counted in the innermost ALLOCATION_PHASE of the thread that made it, or in "other" outside of them. The phases
+ * must not allocate themselves, so they are kept in a fixed array
+ */
+class AllocationStats {
+   public:
+    struct Phase {
+        const char* name = nullptr;
+        std::atomic<long long> allocations = 0;
+        std::atomic<long long> bytes = 0;
+    };
+
+    // sets the phase of the allocations of this thread until the end of the enclosing block
+    class Scope {
+       private:
+        Phase* previous;
+
+       public:
+        explicit Scope(Phase& phase) : previous(current) { current = &phase; }
+        ~Scope() { current = previous; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+   private:
+    static constexpr int MAX_PHASES = 32;
+
+    static inline thread_local Phase* current = nullptr;
+
+    std::mutex mutex;
+    Phase phases[MAX_PHASES];
+    int nPhases = 1;  // phases[0] is "other"
+
+    static AllocationStats& instance() {
+        static AllocationStats stats;
+        return stats;
+    }
+
+    AllocationStats() { phases[0].name = "other"; }
+
+   public:
+    static void record(std::size_t size) {
+        Phase* phase = current != nullptr ? current : &instance().phases[0];
+        phase->allocations.fetch_add(1, std::memory_order_relaxed);
+        phase->bytes.fetch_add((long long)size, std::memory_order_relaxed);
+    }
+
+    // the phase with the given name, created on the first call
+    static Phase& phase(const char* name) {
+        AllocationStats& stats = instance();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+        for (int p = 0; p < stats.nPhases; p++) {
+            if (std::strcmp(stats.phases[p].name, name) == 0) return stats.phases[p];
+        }
+        if (stats.nPhases == MAX_PHASES) return stats.phases[0];
+        stats.phases[stats.nPhases].name = name;
+        return stats.phases[stats.nPhases++];
+    }
+
+    // maximum resident set size of the process in kB, from /proc/self/status (0 if it is not available)
+    static long long peakRss() {
+        std::ifstream status("/proc/self/status");
+        std::string key;
+        long long value;
+        while (status >> key) {
+            if (key == "VmHWM:" && status >> value) return value;
+            status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        return 0;
+    }
+
+    // one line per phase: ALLOC name allocations bytes
+    static void print(std::ostream& out) {
+        AllocationStats& stats = instance();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+        for (int p = 0; p < stats.nPhases; p++) {
+            out << "ALLOC " << stats.phases[p].name << " " << stats.phases[p].allocations << " "
+                << stats.phases[p].bytes << std::endl;
+        }
+    }
+};
+
+#ifdef TSPRD_STATS
+#define ALLOCATION_PHASE(var, name)                                           \
+    static AllocationStats::Phase& var##Phase = AllocationStats::phase(name); \
+    const AllocationStats::Scope var(var##Phase)
+#else
+#define ALLOCATION_PHASE(var, name)
+#endif
+
+#endif  // TSPRD_ALLOCATIONSTATS_H
@@ -2,9 +2,11 @@
 #define TSPRD_DATA_H
 
 #include <algorithm>
+#include <atomic>
 #include <argparse/argparse.hpp>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
@@ -14,6 +16,7 @@
 #include <random>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Instance.h"
@@ -30,10 +33,25 @@ struct AlgParams {
     int itDiv;      // iterations without improvement to diversify
     int timeLimit;  // in seconds
 
+    int nThreads;      // number of threads used to create new individuals (0: all hardware threads)
+    bool initEducate;  // whether to apply the local search on the individuals created at (re)initialization
+    bool cloneCheck;   // whether to detect offspring that are clones of individuals in the population by hashing
+    int eduCacheSize;  // maximum number of education results to keep in cache (0: disabled)
+    double eduCutoff;  // stop the education if the offspring is worse than the worst individual by this ratio (<0: off)
+    int nbGranular;    // number of closest vertices of each vertex considered by the moves pruned by neighbor lists
+    int exactSize;     // maximum number of clients of the routes solved to optimality by the `exact` intra move
+    int exactSolver;   // maximum number of clients of the instances solved by the exact solver instead of the GA
+
     unsigned int seed;  // seed for RNG
 
     std::vector<std::string> intraMoves;  // list of intra-route moves
+    std::vector<bool> intraFirst;         // for each intra-route move, whether to use first improvement
     std::vector<std::string> interMoves;  // list of inter-route moves
+    bool adaptiveMoves;                   // order the moves by their gain per time instead of randomly
+
+    bool stats;                // print the counters of the moves and procedures at the end (needs TSPRD_STATS)
+    std::string traceFile;     // file to write the timeline of the phases in the Chrome trace format (empty: off)
+    std::string progressFile;  // file to append one JSON line per improvement of the best solution (empty: off)
 };
 
 class Data {
@@ -44,20 +62,50 @@ class Data {
     const std::vector<int>& releaseDates;              // release date of each vertex
     const int biggerReleaseDate;                       // the bigger release date in the instance
     const bool symmetric;                              // whether the time matrix is symmetric
+    const std::vector<std::vector<int>> neighbors;     // for each vertex, the `nbGranular` closest other vertices
 
     // parameters for the algorithm
     const AlgParams& params;
 
     // starting time of the algorithm
     const std::chrono::steady_clock::time_point startTime;
+    const std::chrono::steady_clock::time_point deadline;  // end of the time limit
 
     // for RNG
     std::mt19937 generator;
 
+    // set by the SIGTERM and SIGINT handler, the algorithm stops as in the time limit
+    static inline std::atomic<bool> stopRequested = false;
+
     explicit Data(const Instance& instance, const AlgParams& params)
         : V(instance.V), N(V - 1), timesMatrix(instance.timesMatrix), releaseDates(instance.releaseDates),
           biggerReleaseDate(*max_element(releaseDates.begin(), releaseDates.end())), symmetric(instance.symmetric),
-          params(params), startTime(std::chrono::steady_clock::now()), generator(params.seed) {}
+          neighbors(closestVertices(instance.timesMatrix, params.nbGranular)),
+          params(params),
+          startTime(std::chrono::steady_clock::now()), deadline(startTime + std::chrono::seconds(params.timeLimit)),
+          generator(params.seed) {}
+
+    // for each vertex, the `n` other vertices with smaller time from or to it
+    static std::vector<std::vector<int>> closestVertices(const std::vector<std::vector<int>>& W, int n) {
+        const int V = (int)W.size();
+        n = std::min(n, V - 1);
+
+        std::vector<std::vector<int>> closest(V);
+        std::vector<std::pair<int, int>> candidates;
+        for (int i = 0; i < V; i++) {
+            candidates.clear();
+            for (int j = 0; j < V; j++) {
+                if (j != i) candidates.emplace_back(std::min(W[i][j], W[j][i]), j);
+            }
+            std::partial_sort(candidates.begin(), candidates.begin() + n, candidates.end());
+            for (int k = 0; k < n; k++) closest[i].push_back(candidates[k].second);
+        }
+        return closest;
+    }
+
+    // whether the time limit was reached or a stop was requested, also checked between the steps of the searches, so
+    // that a long education stops soon after it instead of only at the end of the generation
+    bool shouldStop() const { return stopRequested || std::chrono::steady_clock::now() >= deadline; }
 
     std::chrono::milliseconds elapsedTime() const {
         return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
@@ -84,10 +132,43 @@ class Data {
             .nargs(argparse::nargs_pattern::any)
             .default_value(
                 std::vector<std::string>{"swap11", "swap12", "swap22", "reinsertion1", "reinsertion2", "2opt"});
+        program.add_argument("--intraStrategy")
+            .help("Improvement strategy (first or best) for all the intra moves, or for each of them")
+            .nargs(argparse::nargs_pattern::any)
+            .default_value(std::vector<std::string>{"best"});
         program.add_argument("--interMoves")
             .help("List of inter moves to be used")
             .nargs(argparse::nargs_pattern::any)
             .default_value(std::vector<std::string>{"relocation", "swap", "divideAndSwap"});
+        program.add_argument("--adaptiveMoves")
+            .help("Order the moves by their measured gain per time of search, instead of uniformly at random")
+            .default_value(false)
+            .implicit_value(true);
+
+        program.add_argument("--stats")
+            .help("Print the calls, gain and time of each move and procedure (needs a build with TSPRD_STATS=ON)")
+            .default_value(false)
+            .implicit_value(true);
+        program.add_argument("--trace")
+            .help("Write the timeline of the phases of the algorithm to this file, in the Chrome trace event format")
+            .default_value("");
+        program.add_argument("--progress")
+            .help("Append one JSON line per improvement of the best solution to this file, flushed immediately")
+            .default_value("");
+
+        program.add_argument("--nbGranular")
+            .help("Number of closest vertices considered by the moves pruned by neighbor lists")
+            .default_value(20)
+            .scan<'i', int>();
+        program.add_argument("--exactSize")
+            .help("Maximum number of clients of the routes solved to optimality by the exact intra move (up to 16)")
+            .default_value(10)
+            .scan<'i', int>();
+
+        program.add_argument("--exactSolver")
+            .help("Solve the instances with up to this many clients (at most 20) with the exact solver, 0 to disable")
+            .default_value(15)
+            .scan<'i', int>();
 
         program.add_argument("--mu").help("Minimum size of the population").default_value(20).scan<'i', int>();
         program.add_argument("--lambda")
@@ -110,6 +191,28 @@ class Data {
             .help("Iterations without improvement to diversify")
             .default_value(4000)
             .scan<'i', int>();
+        program.add_argument("--threads")
+            .help("Number of threads used to create new individuals, 0 to use all hardware threads")
+            .default_value(1)
+            .scan<'i', int>();
+        program.add_argument("--initEducate")
+            .help("Apply the local search to the individuals created at (re)initialization")
+            .default_value(false)
+            .implicit_value(true);
+        program.add_argument("--cloneCheck")
+            .help("Mutate offspring whose giant tour is already in the population and discard educated clones")
+            .default_value(false)
+            .implicit_value(true);
+        program.add_argument("--eduCache")
+            .help("Maximum number of education results to cache by giant tour, 0 to disable the cache")
+            .default_value(0)
+            .scan<'i', int>();
+        program.add_argument("--eduCutoff")
+            .help(
+                "Stop the education after the first intra-route search if the offspring is worse than the worst "
+                "individual in the population by more than this ratio, negative to disable")
+            .default_value(-1.0)
+            .scan<'g', double>();
 
         try {
             program.parse_args(argc, argv);
@@ -122,6 +225,21 @@ class Data {
         std::string instanceFile = program.get<std::string>("instanceFile");
         std::string outputFile = program.get<std::string>("--outputFile");
         int timeLimit = program.get<int>("--timeLimit");
+        int nbGranular = program.get<int>("--nbGranular");
+        if (nbGranular < 1) {
+            std::cout << "The number of granular neighbors must be at least 1" << std::endl;
+            exit(1);
+        }
+        int exactSize = program.get<int>("--exactSize");
+        if (exactSize < 1 || exactSize > 16) {
+            std::cout << "The exact intra move size must be between 1 and 16" << std::endl;
+            exit(1);
+        }
+        int exactSolver = program.get<int>("--exactSolver");
+        if (exactSolver < 0 || exactSolver > 20) {
+            std::cout << "The exact solver size must be between 0 and 20" << std::endl;
+            exit(1);
+        }
         unsigned int seed = program.get<unsigned int>("--seed");
 
         auto intraMoves = program.get<std::vector<std::string>>("--intraMoves");
@@ -133,6 +251,25 @@ class Data {
         if (interMoves.size() == 1 && interMoves[0] == "none") {
             interMoves.clear();
         }
+        bool adaptiveMoves = program.get<bool>("--adaptiveMoves");
+        bool stats = program.get<bool>("--stats");
+        std::string traceFile = program.get<std::string>("--trace");
+        std::string progressFile = program.get<std::string>("--progress");
+
+        auto intraStrategy = program.get<std::vector<std::string>>("--intraStrategy");
+        if (intraStrategy.size() == 1) intraStrategy.resize(intraMoves.size(), intraStrategy[0]);
+        if (intraStrategy.size() != intraMoves.size()) {
+            std::cout << "The number of intra strategies must be 1 or the number of intra moves" << std::endl;
+            exit(1);
+        }
+        std::vector<bool> intraFirst(intraMoves.size());
+        for (int i = 0; i < intraStrategy.size(); i++) {
+            if (intraStrategy[i] != "first" && intraStrategy[i] != "best") {
+                std::cout << "Invalid intra strategy: " << intraStrategy[i] << std::endl;
+                exit(1);
+            }
+            intraFirst[i] = intraStrategy[i] == "first";
+        }
 
         int mu = program.get<int>("--mu");
         int lambda = program.get<int>("--lambda");
@@ -140,6 +277,15 @@ class Data {
         int nClose = program.get<int>("--nClose");
         int itNi = program.get<int>("--itNi");
         int itDiv = program.get<int>("--itDiv");
+        int nThreads = program.get<int>("--threads");
+        bool initEducate = program.get<bool>("--initEducate");
+        bool cloneCheck = program.get<bool>("--cloneCheck");
+        int eduCacheSize = program.get<int>("--eduCache");
+        if (eduCacheSize < 0) {
+            std::cout << "The education cache size must not be negative" << std::endl;
+            exit(1);
+        }
+        double eduCutoff = program.get<double>("--eduCutoff");
 
         if (!std::filesystem::exists(instanceFile)) {
             std::cout << "Not able to find this file: " << instanceFile << std::endl;
@@ -153,9 +299,22 @@ class Data {
                          .itNi = itNi,
                          .itDiv = itDiv,
                          .timeLimit = timeLimit,
+                         .nThreads = nThreads,
+                         .initEducate = initEducate,
+                         .cloneCheck = cloneCheck,
+                         .eduCacheSize = eduCacheSize,
+                         .eduCutoff = eduCutoff,
+                         .nbGranular = nbGranular,
+                         .exactSize = exactSize,
+                         .exactSolver = exactSolver,
                          .seed = seed,
                          .intraMoves = intraMoves,
-                         .interMoves = interMoves};
+                         .intraFirst = intraFirst,
+                         .interMoves = interMoves,
+                         .adaptiveMoves = adaptiveMoves,
+                         .stats = stats,
+                         .traceFile = traceFile,
+                         .progressFile = progressFile};
 
         return std::make_tuple(instanceFile, outputFile, params);
     }
@@ -0,0 +1,100 @@
+#ifndef TSPRD_EDUCATIONCACHE_H
+#define TSPRD_EDUCATIONCACHE_H
+
+#include "Data.hpp"
+#include "Individual.h"
+
+/*
+ * Bounded cache of education results, mapping the fingerprint of a giant tour before the education
+ * to the individual obtained by educating and splitting it
+ * when full, the entry to be replaced is chosen by the CLOCK (second chance) policy
+ */
+class EducationCache {
+   public:
+    struct Fingerprint {  // 128 bits from two independent hashes of the giant tour
+        uint64_t zobrist;
+        uint64_t fnv;
+
+        bool operator==(const Fingerprint& other) const { return zobrist == other.zobrist && fnv == other.fnv; }
+    };
+
+   private:
+    struct FingerprintHash {
+        size_t operator()(const Fingerprint& f) const { return f.zobrist; }
+    };
+
+    struct Entry {
+        Fingerprint key;
+        Individual educated;  // educated and split individual, without population data
+        bool referenced;      // whether the entry was used since the last time the clock hand passed by it
+    };
+
+    std::vector<Entry> entries;
+    std::unordered_map<Fingerprint, int, FingerprintHash> slots;  // position in `entries` of each fingerprint
+    int capacity;
+    int N;     // number of clients, to create the entries
+    int hand;  // next entry to be checked for replacement
+
+   public:
+    long long hits;
+    long long misses;
+
+    // capacity 0 disables the cache
+    EducationCache(int capacity, int N) : capacity(capacity), N(N), hand(0), hits(0), misses(0) {
+        entries.reserve(capacity);
+        slots.reserve(capacity);
+    }
+
+    bool enabled() const { return capacity > 0; }
+
+    static Fingerprint fingerprint(const std::vector<int>& giantTour) {
+        Fingerprint f{0, 0xcbf29ce484222325ULL};
+        for (int i = 0; i < (int)giantTour.size(); i++) {
+            f.zobrist ^= Individual::zobristKey(i, giantTour[i]);
+            f.fnv = (f.fnv ^ (uint64_t)giantTour[i]) * 0x100000001b3ULL;
+        }
+        return f;
+    }
+
+    // if `key` is in the cache, copy the educated individual to `indiv` and return true
+    bool load(const Fingerprint& key, Individual* indiv) {
+        auto it = slots.find(key);
+        if (it == slots.end()) {
+            misses++;
+            return false;
+        }
+        hits++;
+
+        Entry& entry = entries[it->second];
+        entry.referenced = true;
+        indiv->copySolution(entry.educated);
+        return true;
+    }
+
+    // store the educated individual `indiv` as the result of educating the giant tour with fingerprint `key`
+    void save(const Fingerprint& key, const Individual* indiv) {
+        if (slots.count(key)) return;
+
+        int slot;
+        if ((int)entries.size() < capacity) {
+            slot = (int)entries.size();
+            entries.push_back({key, Individual(N), false});
+        } else {
+            while (entries[hand].referenced) {  // give a second chance to the recently used entries
+                entries[hand].referenced = false;
+                hand = (hand + 1) % capacity;
+            }
+            slot = hand;
+            hand = (hand + 1) % capacity;
+            slots.erase(entries[slot].key);
+        }
+
+        Entry& entry = entries[slot];
+        entry.key = key;
+        entry.referenced = false;
+        entry.educated.copySolution(*indiv);
+        slots[key] = slot;
+    }
+};
+
+#endif  // TSPRD_EDUCATIONCACHE_H
@@ -0,0 +1,115 @@
+#include "ExactSolver.h"
+
+#include "Trace.hpp"
+
+ExactSolver::ExactSolver(const Data& data) : data(data), n(data.N) {}
+
+bool ExactSolver::heldKarp() {
+    const int nSets = 1 << n;
+    const auto& W = data.timesMatrix;
+
+    path.assign((size_t)nSets * n, INF);
+    tsp.assign(nSets, INF);
+    for (int j = 0; j < n; j++) path[(size_t)(1 << j) * n + j] = W[0][j + 1];
+
+    for (int T = 1; T < nSets; T++) {
+        if (T % STOP_CHECK == 0 && data.shouldStop()) return false;
+        for (int j = 0; j < n; j++) {
+            const int current = path[(size_t)T * n + j];
+            if (!(T & (1 << j)) || current == INF) continue;
+
+            tsp[T] = std::min(tsp[T], current + W[j + 1][0]);
+            for (int k = 0; k < n; k++) {
+                if (T & (1 << k)) continue;
+                int& next = path[(size_t)(T | (1 << k)) * n + k];
+                next = std::min(next, current + W[j + 1][k + 1]);
+            }
+        }
+    }
+    return true;
+}
+
+bool ExactSolver::solveSets() {
+    const int nSets = 1 << n;
+
+    rd.assign(nSets, 0);
+    latest.assign(nSets, 0);
+    for (int S = 1; S < nSets; S++) {
+        const int c = __builtin_ctz(S) + 1;
+        const int rest = S & (S - 1);
+        if (rest == 0 || data.releaseDates[c] > rd[rest]) {
+            rd[S] = data.releaseDates[c];
+            latest[S] = c;
+        } else {
+            rd[S] = rd[rest];
+            latest[S] = latest[rest];
+        }
+    }
+
+    best.assign(nSets, INF);
+    lastRoute.assign(nSets, 0);
+    best[0] = 0;
+    for (int S = 1; S < nSets; S++) {
+        if (S % STOP_CHECK == 0 && data.shouldStop()) return false;
+        // the last route contains the client with the biggest release date
+        const int fixed = 1 << (latest[S] - 1);
+        const int free = S ^ fixed;
+
+        // all the subsets T of S containing `fixed`, from T = S to T = fixed
+        for (int sub = free;; sub = (sub - 1) & free) {
+            const int T = sub | fixed;
+            if (T != 0) {
+                const int time = std::max(best[S ^ T], rd[T]) + tsp[T];
+                if (time < best[S]) {
+                    best[S] = time;
+                    lastRoute[S] = T;
+                }
+            }
+            if (sub == 0) break;
+        }
+    }
+    return true;
+}
+
+std::vector<int> ExactSolver::routeOrder(int T) const {
+    const auto& W = data.timesMatrix;
+    std::vector<int> order;
+
+    // find the last client of the route, then go back through the Held-Karp paths
+    int last = -1;
+    for (int j = 0; j < n && last == -1; j++) {
+        if ((T & (1 << j)) && path[(size_t)T * n + j] + W[j + 1][0] == tsp[T]) last = j;
+    }
+    while (true) {
+        order.push_back(last + 1);
+        const int rest = T ^ (1 << last);
+        if (rest == 0) break;
+
+        const int time = path[(size_t)T * n + last];
+        for (int j = 0; j < n; j++) {
+            if ((rest & (1 << j)) && path[(size_t)rest * n + j] + W[j + 1][last + 1] == time) {
+                last = j;
+                break;
+            }
+        }
+        T = rest;
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<int> ExactSolver::solve() {
+    TRACE_SCOPE("exactSolver");
+    if (!heldKarp() || !solveSets()) return {};
+
+    std::vector<std::vector<int>> routes;  // from the last to the first
+    for (int S = (1 << n) - 1; S != 0; S ^= lastRoute[S]) routes.push_back(routeOrder(lastRoute[S]));
+
+    std::vector<int> giantTour;
+    giantTour.reserve(n);
+    for (auto it = routes.rbegin(); it != routes.rend(); it++) {
+        giantTour.insert(giantTour.end(), it->begin(), it->end());
+    }
+    return giantTour;
+}
@@ -0,0 +1,46 @@
+#ifndef TSPRD_EXACTSOLVER_H
+#define TSPRD_EXACTSOLVER_H
+
+#include "Data.hpp"
+
+/*
+ * Exact dynamic programming for small instances
+ *
+ * best[S] is the minimum time to serve the set of clients S and return to the depot, and the last route of it
+ * serves some subset T of S, starting after the release dates of T and after the routes serving S \ T, so
+ *     best[S] = min { max(best[S \ T], rd(T)) + tsp(T) : T subset of S }
+ * where tsp(T) is the time of the shortest route visiting T, from the Held-Karp dynamic programming
+ *
+ * with the triangle inequality, there is an optimal solution where the client with the biggest release date is in
+ * the last route, since the routes from the one serving it on never wait and can be joined in a single route,
+ * so only the subsets T with that client are considered. This takes O(2^n * n^2 + 3^n) time and O(2^n * n) memory
+ */
+class ExactSolver {
+   private:
+    const Data& data;
+    const int n;  // number of clients, the client c is the bit (c - 1) of the sets
+
+    std::vector<int> path;       // path[T * n + j]: min time leaving the depot, visiting T and ending at client j + 1
+    std::vector<int> tsp;        // time of the shortest route visiting each set
+    std::vector<int> rd;         // release date of each set
+    std::vector<int> latest;     // client with the biggest release date in each set
+    std::vector<int> best;       // best[S]: min time to serve S
+    std::vector<int> lastRoute;  // clients in the last route of the solution of best[S]
+
+    // both return false if the run was stopped before they finished
+    bool heldKarp();
+    bool solveSets();
+    std::vector<int> routeOrder(int T) const;  // visiting order of the shortest route visiting T
+
+   public:
+    static constexpr int MAX_CLIENTS = 20;
+    static constexpr int STOP_CHECK = 1024;  // number of sets between the checks of the time limit
+
+    explicit ExactSolver(const Data& data);
+
+    // giant tour of an optimal solution, with the routes in the order they are performed, or an empty giant tour if
+    // the run was stopped (time limit or signal) before it was found
+    std::vector<int> solve();
+};
+
+#endif  // TSPRD_EXACTSOLVER_H
@@ -1,22 +1,40 @@
 #include "GeneticAlgorithm.h"
 
-GeneticAlgorithm::GeneticAlgorithm(Data& data) : data(data), split(data), localSearch(data), population(data, split) {
-    std::chrono::milliseconds maxTime(this->data.params.timeLimit * 1000);
+#include "AllocationStats.hpp"
+#include "ExactSolver.h"
+#include "HardwareCounters.hpp"
+#include "LowerBound.h"
+#include "Trace.hpp"
+
+GeneticAlgorithm::GeneticAlgorithm(Data& data)
+    : data(data), split(data), localSearch(data), population(data, split),
+      educationCache(data.params.eduCacheSize, data.N), lowerBound(0), provenOptimal(false), iterations(0) {
+    // if the exact solver is stopped, the population is still created to have a solution to output
+    if (data.N <= data.params.exactSolver && solveExactly()) return;
+
+    lowerBound = LowerBound(data).calculate();
 
     population.initialize();
 
     int itNotImproved = 0;
-    while (itNotImproved < this->data.params.itNi && data.elapsedTime() < maxTime) {
+    while (itNotImproved < this->data.params.itNi && !data.shouldStop() && population.bestSolution.eval > lowerBound) {
+        population.generation = ++iterations;
         auto offspring = orderCrossover();
+        if (data.params.cloneCheck) mutateClone(offspring);
 
-        localSearch.educate(*offspring);
-        split.split(offspring);  // todo verify if this is necessary
+        bool educated = educate(offspring);
 
-        bool improvedBest = population.add(offspring);
+        bool improvedBest = false;
+        if (!educated || (data.params.cloneCheck && population.hasSolution(offspring->solutionHash))) {
+            // the offspring would not survive, and a clone would be the first individual removed in the selection
+            population.individualPool.release(offspring);
+        } else {
+            improvedBest = population.add(offspring);
 
-        // Check if the population reached the maximum size
-        if (population.size() > data.params.mu + data.params.lambda) {
-            population.survivorsSelection();
+            // Check if the population reached the maximum size
+            if (population.size() > data.params.mu + data.params.lambda) {
+                population.survivorsSelection();
+            }
         }
 
         if (improvedBest) {
@@ -26,11 +44,55 @@ GeneticAlgorithm::GeneticAlgorithm(Data& data) : data(data), split(data), localS
             if (itNotImproved % data.params.itDiv == 0) population.diversify();
         }
     }
+
+    provenOptimal = population.bestSolution.eval <= lowerBound;
+}
+
+// small instances are solved to optimality instead of running the genetic algorithm
+// returns false if the run was stopped before the optimal solution was found
+bool GeneticAlgorithm::solveExactly() {
+    std::vector<int> giantTour = ExactSolver(data).solve();
+    if (giantTour.empty()) return false;
+
+    auto indiv = population.individualPool.acquire();
+    indiv->giantTour = std::move(giantTour);
+    split.split(indiv);
+    population.add(indiv);
+    lowerBound = indiv->eval;
+    provenOptimal = true;
+    return true;
+}
+
+// apply the local search and split the offspring, reusing the result of a previous education of the same giant tour
+// returns false if the education was stopped early because the offspring is too bad compared to the population
+bool GeneticAlgorithm::educate(Individual* offspring) {
+    TRACE_SCOPE("education");
+    HW_COUNTERS(hwCounters, "education");
+    ALLOCATION_PHASE(allocationPhase, "education");
+    EducationCache::Fingerprint key{};
+    if (educationCache.enabled()) {
+        key = EducationCache::fingerprint(offspring->giantTour);
+        if (educationCache.load(key, offspring)) return true;
+    }
+
+    int cutoff = INF;
+    if (data.params.eduCutoff >= 0 && population.size() > 0) {
+        cutoff = (int)(population.individuals.back()->eval * (1.0 + data.params.eduCutoff));
+    }
+
+    if (!localSearch.educate(*offspring, cutoff)) return false;  // the offspring is discarded, no need to split it
+    split.split(offspring);  // todo verify if this is necessary
+
+    if (educationCache.enabled()) educationCache.save(key, offspring);
+    return true;
 }
 
 Individual* GeneticAlgorithm::orderCrossover() {
+    TRACE_SCOPE("crossover");
+    HW_COUNTERS(hwCounters, "crossover");
+    ALLOCATION_PHASE(allocationPhase, "crossover");
     auto [parent1, parent2] = population.selectParents();
-    auto offspring = new Individual(data.N);
+    auto offspring = population.individualPool.acquire();
 
     std::uniform_int_distribution<int> dist(0, data.N - 1);
     std::vector<bool> has(data.V, false);  // mark which vertices are already in the offstring
@@ -54,3 +116,12 @@ Individual* GeneticAlgorithm::orderCrossover() {
 
     return offspring;
 }
+
+// an offspring with the same giant tour of an individual in the population would most likely be educated
+// to a clone of it, so swap random pairs of clients until the giant tour is new
+void GeneticAlgorithm::mutateClone(Individual* offspring) {
+    std::uniform_int_distribution<int> dist(0, data.N - 1);
+    for (int tries = 0; tries < 10 && population.hasTour(offspring->hashTour()); tries++) {
+        std::swap(offspring->giantTour[dist(data.generator)], offspring->giantTour[dist(data.generator)]);
+    }
+}
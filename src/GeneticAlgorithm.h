@@ -2,6 +2,7 @@
 #define TSPRD_GENETICALGORITHM_H
 
 #include "Data.hpp"
+#include "EducationCache.hpp"
 #include "NeighborSearch.hpp"
 #include "Population.h"
 #include "Split.h"
@@ -12,12 +13,19 @@ class GeneticAlgorithm {
     Split split;
     NeighborSearch localSearch;
     Population population;
+    EducationCache educationCache;
+    int lowerBound;      // the algorithm stops if the best solution reaches this value
+    bool provenOptimal;  // whether the best solution was proven optimal, by the exact solver or the lower bound
+    int iterations;      // number of offspring generated
 
     GeneticAlgorithm(Data& instance);
 
     Individual* orderCrossover();
+    void mutateClone(Individual* offspring);
+    bool educate(Individual* offspring);
 
     void diversify();
+    bool solveExactly();
 };
 
 #endif  // TSPRD_GENETICALGORITHM_H
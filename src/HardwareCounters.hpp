@@ -0,0 +1,220 @@
+#ifndef TSPRD_HARDWARECOUNTERS_H
+#define TSPRD_HARDWARECOUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Hardware counters (cycles, instructions, L1 data and last level cache misses, branch misses) of the main phases,
+ * read with perf_event_open and printed by --stats as one line per phase
+ *
+ * like the Stats counters, they are only compiled with TSPRD_STATS. Each thread opens its own group of counters on
+ * its first measured phase. If the kernel does not allow it (perf_event_paranoid, containers, virtual machines
+ * without a PMU) the phases are not measured and the reason is printed instead. A counter that is not supported by
+ * the CPU is printed as -1. When the kernel multiplexes the counters with other events they are scaled by the time
+ * enabled over the time running, and the calls of a phase in which they did not run at all are not counted
+ */
+class HardwareCounters {
+   public:
+    static constexpr int N_EVENTS = 5;
+    using Values = std::array<uint64_t, N_EVENTS>;
+
+    // the values of the counters of a group and for how long the group was enabled and running, in ns
+    struct Reading {
+        Values values{};
+        uint64_t enabled = 0, running = 0;
+    };
+
+    struct Phase {
+        const std::string name;
+        std::atomic<long long> calls = 0;
+        std::atomic<long long> unscheduled = 0;  // calls in which the counters were not running at all
+        std::array<std::atomic<uint64_t>, N_EVENTS> totals{};
+
+        explicit Phase(std::string name) : name(std::move(name)) {}
+    };
+
+    // adds the counters from its construction to its destruction to the phase
+    class Scope {
+       private:
+        Phase& phase;
+        Reading start{};
+        bool measuring;
+
+       public:
+        explicit Scope(Phase& phase) : phase(phase), measuring(active() && read(start)) {}
+        ~Scope() {
+            Reading end{};
+            if (!measuring || !read(end)) return;
+            const uint64_t enabled = end.enabled - start.enabled, running = end.running - start.running;
+            if (running == 0) {  // the group was never scheduled on the PMU during the phase
+                phase.unscheduled.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            // when the kernel multiplexes the counters, they only count part of the time and are scaled up
+            const double scale = (double)enabled / (double)running;
+            phase.calls.fetch_add(1, std::memory_order_relaxed);
+            for (int e = 0; e < N_EVENTS; e++) {
+                const auto value = (uint64_t)((double)(end.values[e] - start.values[e]) * scale + 0.5);
+                phase.totals[e].fetch_add(value, std::memory_order_relaxed);
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+   private:
+    // the counters of one thread, read together as a group
+    struct Group {
+        int leader = -1;
+        std::array<int, N_EVENTS> fds{};
+        std::array<int, N_EVENTS> position{};  // position of each event in the group read, -1 if not supported
+
+        Group() {
+            position.fill(-1);
+            fds.fill(-1);
+#ifdef __linux__
+            const std::array<std::pair<uint32_t, uint64_t>, N_EVENTS> events = {{
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            }};
+            int n = 0;
+            for (int e = 0; e < N_EVENTS; e++) {
+                perf_event_attr attr{};
+                attr.size = sizeof(attr);
+                attr.type = events[e].first;
+                attr.config = events[e].second;
+                attr.read_format =
+                    PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                fds[e] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+                if (fds[e] == -1) {
+                    if (leader == -1) {  // without the cycles the other counters are not measured either
+                        failure(std::string("perf_event_open: ") + std::strerror(errno));
+                        return;
+                    }
+                    continue;
+                }
+                if (leader == -1) leader = fds[e];
+                position[e] = n++;
+                instance().supported[e] = true;
+            }
+#else
+            failure("perf_event_open is only available on Linux");
+#endif
+        }
+
+        ~Group() {
+#ifdef __linux__
+            for (int fd : fds) {
+                if (fd != -1) close(fd);
+            }
+#endif
+        }
+    };
+
+    std::mutex mutex;
+    std::deque<Phase> phases;  // in the order they were created, a deque keeps the references valid
+    std::atomic<bool> enabled = false;
+    std::array<std::atomic<bool>, N_EVENTS> supported{};  // whether each event could be opened
+    std::string failureReason;
+
+    static HardwareCounters& instance() {
+        static HardwareCounters counters;
+        return counters;
+    }
+
+    static bool active() { return instance().enabled.load(std::memory_order_relaxed); }
+
+    static void failure(const std::string& reason) {
+        HardwareCounters& counters = instance();
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        if (counters.failureReason.empty()) counters.failureReason = reason;
+    }
+
+    // the current values of the counters of this thread, false if they are not available
+    static bool read(Reading& reading) {
+        thread_local Group group;
+        if (group.leader == -1) return false;
+#ifdef __linux__
+        uint64_t buffer[N_EVENTS + 3];  // the number of counters, the time enabled and running, and the values
+        if (::read(group.leader, buffer, sizeof(buffer)) <= 0) return false;
+        reading.enabled = buffer[1];
+        reading.running = buffer[2];
+        for (int e = 0; e < N_EVENTS; e++) {
+            reading.values[e] = group.position[e] == -1 ? 0 : buffer[3 + group.position[e]];
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+   public:
+    // start measuring the phases, called when the counters will be printed
+    static void enable() { instance().enabled = true; }
+
+    // the phase with the given name, created on the first call
+    static Phase& phase(const std::string& name) {
+        HardwareCounters& counters = instance();
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        for (Phase& p : counters.phases) {
+            if (p.name == name) return p;
+        }
+        return counters.phases.emplace_back(name);
+    }
+
+    // one line per measured phase: HW name calls cycles instructions l1dMisses llcMisses branchMisses
+    static void print(std::ostream& out) {
+        HardwareCounters& counters = instance();
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        if (!counters.failureReason.empty()) {
+            out << "HW unavailable: " << counters.failureReason << std::endl;
+            return;
+        }
+
+        for (const Phase& p : counters.phases) {
+            if (p.calls == 0) {
+                if (p.unscheduled > 0) out << "HW " << p.name << " unavailable: counters never scheduled" << std::endl;
+                continue;
+            }
+            out << "HW " << p.name << " " << p.calls;
+            for (int e = 0; e < N_EVENTS; e++) {
+                if (!counters.supported[e]) {
+                    out << " -1";
+                } else {
+                    out << " " << p.totals[e];
+                }
+            }
+            out << std::endl;
+        }
+    }
+};
+
+#ifdef TSPRD_STATS
+#define HW_COUNTERS(var, name)                                               \
+    static HardwareCounters::Phase& var##Phase = HardwareCounters::phase(name); \
+    const HardwareCounters::Scope var(var##Phase)
+#else
+#define HW_COUNTERS(var, name)
+#endif
+
+#endif  // TSPRD_HARDWARECOUNTERS_H
@@ -9,19 +9,80 @@ class Individual {
     std::vector<int> giantTour;                             // giant tour representation (chromossome)
     std::vector<int> successors;                            // for each client (1:V), the successor in the solution
     std::vector<int> predecessors;                          // for each client (1:V), the predecessor in the solution
-    std::multiset<std::pair<double, Individual*>> closest;  // Other individuals sorted by distance
+    std::vector<std::pair<double, Individual*>> closest;    // Other individuals sorted by distance
     double biasedFitness;                                   // this solution biased fitness
+    uint64_t tourHash;                                      // hash of the giant tour, updated by the split
+    uint64_t solutionHash;                                  // hash of the successors and predecessors after the split
 
     Individual(Data& data)  // create a random individual only with the giant tour
         : eval(INF), giantTour(data.N), successors(data.V), predecessors(data.V), closest(),
-          biasedFitness(std::numeric_limits<double>::max()) {
-        std::iota(giantTour.begin(), giantTour.end(), 1);
-        std::shuffle(giantTour.begin(), giantTour.end(), data.generator);
+          biasedFitness(std::numeric_limits<double>::max()), tourHash(0), solutionHash(0) {
+        randomTour(data.generator);
     }
 
     Individual(int N)  // create a empty individual
         : eval(INF), giantTour(N), successors(N + 1), predecessors(N + 1), closest(),
-          biasedFitness(std::numeric_limits<double>::max()) {}
+          biasedFitness(std::numeric_limits<double>::max()), tourHash(0), solutionHash(0) {}
+
+    // set the giant tour to a random permutation of the clients
+    void randomTour(std::mt19937& generator) {
+        std::iota(giantTour.begin(), giantTour.end(), 1);
+        std::shuffle(giantTour.begin(), giantTour.end(), generator);
+    }
+
+    // clear the evaluation and the population data, keeping the allocated memory
+    void reset() {
+        eval = INF;
+        closest.clear();
+        biasedFitness = std::numeric_limits<double>::max();
+        tourHash = 0;
+        solutionHash = 0;
+    }
+
+    // keep `closest` sorted in a vector, so its memory is reused along with the individual
+    void addClose(double distance, Individual* other) {
+        const std::pair<double, Individual*> entry(distance, other);
+        closest.insert(std::upper_bound(closest.begin(), closest.end(), entry), entry);
+    }
+
+    void removeClose(const Individual* other) {
+        closest.erase(std::find_if(closest.begin(), closest.end(), [other](auto& c) { return c.second == other; }));
+    }
+
+    // copy the solution data of another individual, reusing the memory of this one
+    void copySolution(const Individual& from) {
+        eval = from.eval;
+        giantTour.assign(from.giantTour.begin(), from.giantTour.end());
+        successors.assign(from.successors.begin(), from.successors.end());
+        predecessors.assign(from.predecessors.begin(), from.predecessors.end());
+        tourHash = from.tourHash;
+        solutionHash = from.solutionHash;
+    }
+
+    /*
+     * Zobrist key for having `value` at position `index` of some array
+     * the keys are generated by mixing the pair (splitmix64) instead of being stored in a N x N table
+     */
+    static uint64_t zobristKey(int index, int value) {
+        uint64_t z = ((uint64_t)(unsigned int)index << 32 | (unsigned int)value) + 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t hashTour() const {
+        uint64_t hash = 0;
+        for (int i = 0; i < (int)giantTour.size(); i++) hash ^= zobristKey(i, giantTour[i]);
+        return hash;
+    }
+
+    // individuals with the same routes have the same hash, which matches a zero `Population::distance` between them
+    uint64_t hashSolution() const {
+        const int V = (int)successors.size();
+        uint64_t hash = 0;
+        for (int i = 0; i < V; i++) hash ^= zobristKey(i, successors[i]) ^ zobristKey(V + i, predecessors[i]);
+        return hash;
+    }
 };
 
 #endif  // TSPRD_INDIVIDUAL_H
@@ -0,0 +1,46 @@
+#ifndef TSPRD_INDIVIDUALPOOL_H
+#define TSPRD_INDIVIDUALPOOL_H
+
+#include "Data.hpp"
+#include "Individual.h"
+
+// keeps the individuals created along the algorithm to be reused, instead of allocating one for each offspring
+class IndividualPool {
+   private:
+    int N;                            // number of clients
+    std::vector<Individual*> all;     // every individual created by the pool
+    std::vector<Individual*> unused;  // individuals available to be acquired
+
+   public:
+    IndividualPool(int N, int capacity) : N(N) {
+        all.reserve(capacity);
+        unused.reserve(capacity);
+        for (int i = 0; i < capacity; i++) all.push_back(new Individual(N));
+        unused.assign(all.rbegin(), all.rend());
+    }
+
+    ~IndividualPool() {
+        for (auto* indiv : all) delete indiv;
+    }
+
+    IndividualPool(const IndividualPool&) = delete;
+    IndividualPool& operator=(const IndividualPool&) = delete;
+
+    // return an empty individual, only creating a new one if all the individuals of the pool are in use
+    Individual* acquire() {
+        if (unused.empty()) {
+            all.push_back(new Individual(N));
+            return all.back();
+        }
+
+        auto* indiv = unused.back();
+        unused.pop_back();
+        indiv->reset();
+        return indiv;
+    }
+
+    // give back an individual that is no longer in use
+    void release(Individual* indiv) { unused.push_back(indiv); }
+};
+
+#endif  // TSPRD_INDIVIDUALPOOL_H
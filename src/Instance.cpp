@@ -1,5 +1,7 @@
 #include "Instance.h"
 
+#include "Trace.hpp"
+
 // read the stream until 's' appear
 void readUntil(std::ifstream& in, const std::string& s) {
     std::string x;
@@ -9,7 +11,9 @@ void readUntil(std::ifstream& in, const std::string& s) {
 }
 
 void floydWarshall(std::vector<std::vector<int> >& W) {
-    // apply floyd warshall algorithm to ensure triangular inequality
+    TRACE_SCOPE("floydWarshall");
+    // apply floyd warshall algorithm to ensure triangular inequality, which the moves, the exact solver and the
+    // lower bound rely on
     for (int k = 0; k < W.size(); k++) {
         for (int i = 0; i < W.size(); i++) {
             for (int j = 0; j < W.size(); j++) {
@@ -20,6 +24,7 @@ void floydWarshall(std::vector<std::vector<int> >& W) {
 }
 
 Instance::Instance(const std::string& instanceFile) : V(0), timesMatrix(0), releaseDates(0) {
+    TRACE_SCOPE("instance.load");
     std::ifstream fin(instanceFile, std::ios::in);
     auto firstChar = fin.peek();
 
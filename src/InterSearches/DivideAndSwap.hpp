@@ -7,7 +7,7 @@
 #include "../Solution.h"
 #include "InterSearch.hpp"
 
-class DivideAndSwap : public InterSearch {
+class DivideAndSwap final : public InterSearch {
    private:
     // try to insert a depot in a route, and reorder the routes per release time
     bool divideAndSwapIt(Solution* s) {
@@ -87,12 +87,12 @@ class DivideAndSwap : public InterSearch {
    public:
     explicit DivideAndSwap(Data& data) : InterSearch(data) {}
 
-    int search(Solution* solution) {
+    int search(Solution* solution) override {
         int originalTime = solution->time;
         bool improved;
         do {
             improved = divideAndSwapIt(solution);
-        } while (improved);
+        } while (improved && !data.shouldStop());
         return originalTime - solution->time;
     }
 };
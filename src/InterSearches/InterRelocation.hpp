@@ -6,12 +6,17 @@
 #include "../Solution.h"
 #include "InterSearch.hpp"
 
-class InterRelocation : public InterSearch {
+class InterRelocation final : public InterSearch {
    private:
     int interRelocationIt(Solution* solution, int r1, int r2) {
         std::vector<int>* route1 = solution->routes[r1];
         std::vector<int>* route2 = solution->routes[r2];
 
+        // with the triangle inequality, the route receiving the vertex can't end earlier, and the other can't end later
+        // so if r1 is the last of the two routes and its starting time can't decrease, no relocation improves it
+        if (r1 > r2 && releaseBoundBetween(solution, r2, r1)) return 0;
+        const int originalEnd = solution->routeStart[std::max(r1, r2)] + solution->routeTime[std::max(r1, r2)];
+
         // try to remove a vertex from r2 and put in r1
         for (int i = F(route2); i <= L(route2); i++) {
             int vertex = route2->at(i);
@@ -27,6 +32,10 @@ class InterRelocation : public InterSearch {
             // check release date of route1, when inserting 'vertex'
             int r1RD = std::max(solution->routeRD[r1], data.releaseDates[vertex]);
 
+            // lower bounds for the new ending time of the last of the two routes
+            if (r1 > r2 && r1RD + solution->routeTime[r1] >= originalEnd) continue;
+            if (r2 > r1 && std::max(r2RD, previousEnd(solution, r2)) + r2Time >= originalEnd) continue;
+
             // check where to put vertex to have the smaller route time
             int r1Time = INF;
             int bestJ;
@@ -55,13 +64,14 @@ class InterRelocation : public InterSearch {
    public:
     explicit InterRelocation(Data& data) : InterSearch(data) {}
 
-    int search(Solution* solution) {
+    int search(Solution* solution) override {
         const int originalTime = solution->time;
 
         int gain;
         do {
             gain = 0;
             for (auto& routePair : getRoutesPairSequence(solution->routes.size())) {
+                if (data.shouldStop()) break;
                 auto& r1 = routePair.first;
                 auto& r2 = routePair.second;
                 int gainIt;
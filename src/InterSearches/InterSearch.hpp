@@ -37,6 +37,42 @@ class InterSearch {
         return time;
     }
 
+    // summary of the routes between r1 and r2 (r1 < r2): starting at time t, they finish at max(t + time, end)
+    struct RoutesBetween {
+        int previousEnd;  // ending time of the route before r1
+        int time;
+        int end;
+    };
+
+    RoutesBetween routesBetween(Solution* s, int r1, int r2) {
+        RoutesBetween between{r1 == 0 ? 0 : s->routeStart[r1 - 1] + s->routeTime[r1 - 1], 0, 0};
+        for (int r = r1 + 1; r < r2; r++) {
+            between.time += s->routeTime[r];
+            between.end = std::max(between.end, s->routeRD[r]) + s->routeTime[r];
+        }
+        return between;
+    }
+
+    // ending time of the route r2 when the routes r1 and r2 (r1 < r2) change to (r1RD, r1Time) and (r2RD, r2Time)
+    // same as `calculateEndingTime`, but in O(1) given the summary of the routes between them
+    static int calculateEndingTime(const RoutesBetween& between, int r1RD, int r1Time, int r2RD, int r2Time) {
+        int time = std::max(between.previousEnd, r1RD) + r1Time;
+        time = std::max(time + between.time, between.end);
+        return std::max(time, r2RD) + r2Time;
+    }
+
+    // ending time of the route before r, or 0 if r is the first route
+    static int previousEnd(Solution* s, int r) { return r == 0 ? 0 : s->routeStart[r - 1] + s->routeTime[r - 1]; }
+
+    // whether some route in (r1, r2] starts at its release date (r1 < r2)
+    // if so, the starting time of r2 can't decrease while the ending time of r1 doesn't increase
+    static bool releaseBoundBetween(Solution* s, int r1, int r2) {
+        for (int r = r1 + 1; r <= r2; r++) {
+            if (s->routeStart[r] == s->routeRD[r]) return true;
+        }
+        return false;
+    }
+
     // calculate the release date of the route 'r' in solution when removing 'vertex'
     int routeReleaseDateRemoving(Solution* s, int r, int vertex) {
         int rd = s->routeRD[r];
@@ -88,6 +124,7 @@ class InterSearch {
 
    public:
     virtual int search(Solution* solution) = 0;
+    virtual ~InterSearch() = default;
 };
 
 #endif  // TSPRD_INTERSEARCH_H
@@ -1,29 +1,52 @@
 #ifndef TSPRD_INTERSEARCHALGO_H
 #define TSPRD_INTERSEARCHALGO_H
 
+#include <variant>
 #include <vector>
 
+#include "../MoveSelector.hpp"
+#include "../Stats.hpp"
 #include "DivideAndSwap.hpp"
 #include "InterRelocation.hpp"
 #include "InterSearch.hpp"
 #include "InterSwap.hpp"
+#include "InterSwapStar.hpp"
+#include "InterTwoOptStar.hpp"
+#include "RouteMerge.hpp"
+
+// known searches are stored by value and called without virtual dispatch, as in `IntraMove`
+using InterMove = std::variant<InterRelocation, InterSwap, DivideAndSwap, InterTwoOptStar, InterSwapStar, RouteMerge>;
 
 class InterSearchAlgo {
    private:
-    std::vector<InterSearch*> searches;
-    std::mt19937 generator;
+    const Data& data;
+    std::vector<InterMove> searches;
+    MoveSelector selector;  // order in which the searches are tried
+    std::vector<Stats::Counter*> moveStats;
 
-    void shuffleSearches() { shuffle(searches.begin(), searches.end(), generator); }
+   public:
+    static int searchSolution(InterMove& move, Solution* solution) {
+        return std::visit([solution](auto& search) { return search.search(solution); }, move);
+    }
 
-    std::vector<InterSearch*> parseNames(std::vector<std::string> names, Data& data) {
-        std::vector<InterSearch*> searches;
+    static std::vector<InterMove> parseNames(const std::vector<std::string>& names, Data& data) {
+        std::vector<InterMove> searches;
+        searches.reserve(names.size());
         for (auto& name : names) {
             if (name == "relocation") {
-                searches.push_back(new InterRelocation(data));
+                searches.emplace_back(std::in_place_type<InterRelocation>, data);
             } else if (name == "swap") {
-                searches.push_back(new InterSwap(data));
+                searches.emplace_back(std::in_place_type<InterSwap>, data);
             } else if (name == "divideAndSwap") {
-                searches.push_back(new DivideAndSwap(data));
+                searches.emplace_back(std::in_place_type<DivideAndSwap>, data);
+            } else if (name == "twoOptStar") {
+                searches.emplace_back(std::in_place_type<InterTwoOptStar>, data);
+            } else if (name == "swapStar") {
+                searches.emplace_back(std::in_place_type<InterSwapStar>, data);
+            } else if (name == "merge") {
+                searches.emplace_back(std::in_place_type<RouteMerge>, data, false);
+            } else if (name == "mergeReorder") {
+                searches.emplace_back(std::in_place_type<RouteMerge>, data, true);
             } else {
                 std::cerr << "Invalid inter-route search name: " << name << std::endl;
                 exit(1);
@@ -33,28 +56,40 @@ class InterSearchAlgo {
         return searches;
     }
 
-   public:
-    InterSearchAlgo(Data& data) : searches(parseNames(data.params.interMoves, data)), generator(data.generator) {}
+    InterSearchAlgo(Data& data)
+        : data(data),
+          searches(parseNames(data.params.interMoves, data)),
+          selector(data.params.interMoves, data.params.adaptiveMoves, data.generator) {
+        if (Stats::enabled()) {
+            for (auto& name : data.params.interMoves) moveStats.push_back(&Stats::counter("inter." + name));
+        }
+    }
 
     int search(Solution* solution) {
         if (solution->routes.size() == 1) return 0;
 
+        STATS_COUNTER(searchStats, "inter");
+        STATS_START(searchStart);
         int oldTime = solution->time;
-        shuffleSearches();
+        selector.reorder();
 
         int whichSearch = 0;
         bool improved = false;
-        while (whichSearch < searches.size()) {
-            int gain = searches[whichSearch]->search(solution);
+        while (whichSearch < searches.size() && !data.shouldStop()) {
+            const int movement = selector[whichSearch];
+            selector.start();
+            STATS_START(moveStart);
+            int gain = searchSolution(searches[movement], solution);
+            STATS_RECORD(*moveStats[movement], moveStart, gain);
+            selector.finish(movement, gain);
 
             if (gain > 0) {
                 improved = true;
                 if (solution->routes.size() == 1) break;
-                auto& lastMovement = searches[whichSearch];
-                shuffleSearches();
+                selector.reorder();
                 whichSearch = 0;
-                if (searches[0] == lastMovement) {
-                    std::swap(searches[0], searches[searches.size() - 1]);
+                if (selector[0] == movement) {  // do not try the improving move again right away
+                    selector.firstToLast();
                 }
             } else {
                 whichSearch++;
@@ -63,11 +98,18 @@ class InterSearchAlgo {
 
         if (improved) {
             int newTime = solution->update();
+            STATS_RECORD(searchStats, searchStart, oldTime - newTime);
             return oldTime - newTime;
         }
 
+        STATS_RECORD(searchStats, searchStart, 0);
         return 0;
     }
+
+    // start over the move selection, as if the search was constructed with the given generator
+    void reset(const std::mt19937& generator) { selector.reset(generator); }
+
+    void printMoveWeights(std::ostream& out) const { selector.print(out, "inter"); }
 };
 
 #endif  // TSPRD_INTERSEARCHALGO_H
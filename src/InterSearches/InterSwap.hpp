@@ -7,11 +7,12 @@
 #include "../Solution.h"
 #include "InterSearch.hpp"
 
-class InterSwap : public InterSearch {
+class InterSwap final : public InterSearch {
    private:
     int interSwapIt(Solution* solution, int r1, int r2) {
         std::vector<int>* route1 = solution->routes[r1];
         std::vector<int>* route2 = solution->routes[r2];
+        const int originalEnd = solution->routeStart[r2] + solution->routeTime[r2];  // r1 < r2
 
         // try to swap the i-th vertex from r1 with the j-th vertex from r2
         for (int i = F(route1); i <= (int)L(route1); i++) {
@@ -37,6 +38,7 @@ class InterSwap : public InterSearch {
                                    data.timesMatrix[vertex2][route2->at(j + 1)] +
                                    data.timesMatrix[route2->at(j - 1)][vertex1] +
                                    data.timesMatrix[vertex1][route2->at(j + 1)];
+                if (r2RD + r2Time >= originalEnd) continue;  // r2 can't end before its new release date plus its time
 
                 const int routeGain = verifySolutionChangingRoutes(solution, r1, r2, r1RD, r1Time, r2RD, r2Time);
                 if (routeGain > 0) {  // perform movement
@@ -59,6 +61,7 @@ class InterSwap : public InterSearch {
         do {
             gain = 0;
             for (auto& routePair : getRoutesPairSequence(solution->routes.size())) {
+                if (data.shouldStop()) break;
                 int gainIt;
                 do {
                     gainIt = interSwapIt(solution, routePair.first, routePair.second);
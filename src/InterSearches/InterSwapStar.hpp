@@ -0,0 +1,186 @@
+#ifndef TSPRD_INTERSWAPSTAR_H
+#define TSPRD_INTERSWAPSTAR_H
+
+#include <array>
+#include <vector>
+
+#include "../Data.hpp"
+#include "../Solution.h"
+#include "InterSearch.hpp"
+
+/*
+ * SWAP*: exchange a client u of r1 with a client v of r2, but inserting each of them in its best position of the
+ * other route instead of in the place of the other client
+ *
+ * the three cheapest positions to insert each client in each route are cached until the route changes. The best
+ * position of u in r2 without v is either one of the three, if it is not adjacent to v, or the place of v,
+ * so with the release date of the routes without each client, each exchange is evaluated in O(1)
+ */
+class InterSwapStar final : public InterSearch {
+   private:
+    struct Insertion {
+        int cost = INF;
+        int after = -1;  // vertex after which the client is inserted
+    };
+
+    struct TopInsertions {
+        std::array<Insertion, 3> best;  // sorted by cost
+        int version = -1;               // version of the route when the insertions were calculated
+
+        void add(int cost, int after) {
+            if (cost >= best[2].cost) return;
+            best[2] = {cost, after};
+            if (best[2].cost < best[1].cost) std::swap(best[1], best[2]);
+            if (best[1].cost < best[0].cost) std::swap(best[0], best[1]);
+        }
+    };
+
+    std::vector<std::vector<TopInsertions>> insertions;  // for each route and client, the cheapest insertions
+    std::vector<int> routeVersion;                       // changed each time the route changes
+    int lastVersion = 0;
+
+    // release date of each route without each of its clients
+    std::vector<int> rdWithout1, rdWithout2;
+
+    const TopInsertions& topInsertions(Solution* s, int r, int client) {
+        TopInsertions& top = insertions[r][client];
+        if (top.version == routeVersion[r]) return top;
+
+        top = TopInsertions();
+        top.version = routeVersion[r];
+        const std::vector<int>* route = s->routes[r];
+        for (int j = 0; j < (int)route->size() - 1; j++) {
+            top.add(data.timesMatrix[route->at(j)][client] + data.timesMatrix[client][route->at(j + 1)] -
+                        data.timesMatrix[route->at(j)][route->at(j + 1)],
+                    route->at(j));
+        }
+        return top;
+    }
+
+    // release date of the route without each of its clients, from the two biggest release dates in the route
+    void loadReleaseDates(const std::vector<int>* route, std::vector<int>& rdWithout) {
+        int max1 = 0, max2 = 0, maxPos = -1;
+        for (int i = F(route); i <= (int)L(route); i++) {
+            const int rd = data.releaseDates[route->at(i)];
+            if (rd > max1) {
+                max2 = max1, max1 = rd, maxPos = i;
+            } else if (rd > max2) {
+                max2 = rd;
+            }
+        }
+        rdWithout.assign(route->size(), max1);
+        if (maxPos != -1) rdWithout[maxPos] = max2;
+    }
+
+    // cost of removing the client at position i and inserting `client` in its best position in the route
+    // `after` is set to the vertex after which to insert the client, or -1 to insert it in the place of the removed
+    int replaceCost(Solution* s, int r, int i, int client, int& after) {
+        const std::vector<int>* route = s->routes[r];
+        const int prev = route->at(i - 1), removed = route->at(i), next = route->at(i + 1);
+
+        // insert in the place of the removed client
+        int cost = data.timesMatrix[prev][client] + data.timesMatrix[client][next] - data.timesMatrix[prev][removed] -
+                   data.timesMatrix[removed][next];
+        after = -1;
+
+        const int removeCost = data.timesMatrix[prev][next] - data.timesMatrix[prev][removed] -
+                               data.timesMatrix[removed][next];
+        for (const Insertion& insertion : topInsertions(s, r, client).best) {
+            if (insertion.after == -1) break;
+            if (insertion.after == prev || insertion.after == removed) continue;  // adjacent to the removed client
+            if (removeCost + insertion.cost < cost) {
+                cost = removeCost + insertion.cost;
+                after = insertion.after;
+            }
+            break;  // the next insertions are not cheaper
+        }
+        return cost;
+    }
+
+    static void replace(std::vector<int>* route, int i, int client, int after) {
+        if (after == -1) {
+            route->at(i) = client;
+            return;
+        }
+        route->erase(route->begin() + i);
+        auto it = std::find(route->begin(), route->end() - 1, after);
+        route->insert(it + 1, client);
+    }
+
+    int swapStarIt(Solution* s, int r1, int r2) {
+        std::vector<int>* route1 = s->routes[r1];
+        std::vector<int>* route2 = s->routes[r2];
+        loadReleaseDates(route1, rdWithout1);
+        loadReleaseDates(route2, rdWithout2);
+
+        const RoutesBetween between = routesBetween(s, r1, r2);
+        const int originalEnd = s->routeStart[r2] + s->routeTime[r2];
+
+        int bestEnd = originalEnd, bestI = -1, bestJ = -1, bestAfter1 = -1, bestAfter2 = -1;
+        int bestRD1 = 0, bestRD2 = 0, bestTime1 = 0, bestTime2 = 0;
+        for (int i = F(route1); i <= (int)L(route1); i++) {
+            const int u = route1->at(i);
+            for (int j = F(route2); j <= (int)L(route2); j++) {
+                const int v = route2->at(j);
+
+                const int r1RD = std::max(rdWithout1[i], data.releaseDates[v]);
+                const int r2RD = std::max(rdWithout2[j], data.releaseDates[u]);
+
+                // the ending time can't improve if r2 still can't start before its current ending time
+                if (r2RD >= originalEnd) continue;
+
+                int after1, after2;
+                const int r1Time = s->routeTime[r1] + replaceCost(s, r1, i, v, after1);
+                const int r2Time = s->routeTime[r2] + replaceCost(s, r2, j, u, after2);
+
+                const int end = calculateEndingTime(between, r1RD, r1Time, r2RD, r2Time);
+                if (end < bestEnd) {
+                    bestEnd = end;
+                    bestI = i, bestJ = j, bestAfter1 = after1, bestAfter2 = after2;
+                    bestRD1 = r1RD, bestRD2 = r2RD, bestTime1 = r1Time, bestTime2 = r2Time;
+                }
+            }
+        }
+
+        if (bestEnd == originalEnd) return 0;
+
+        const int u = route1->at(bestI), v = route2->at(bestJ);
+        replace(route1, bestI, v, bestAfter1);
+        replace(route2, bestJ, u, bestAfter2);
+        routeVersion[r1] = ++lastVersion, routeVersion[r2] = ++lastVersion;
+
+        s->routeRD[r1] = bestRD1, s->routeTime[r1] = bestTime1;
+        s->routeRD[r2] = bestRD2, s->routeTime[r2] = bestTime2;
+        s->updateStartingTimes(r1);
+        return originalEnd - bestEnd;
+    }
+
+   public:
+    explicit InterSwapStar(Data& data) : InterSearch(data) {}
+
+    int search(Solution* solution) override {
+        const int originalTime = solution->time;
+        const int nRoutes = (int)solution->routes.size();
+
+        // new versions for all the routes, since the cached insertions are only valid during this search
+        if (insertions.size() < nRoutes) insertions.resize(nRoutes, std::vector<TopInsertions>(data.V));
+        routeVersion.resize(nRoutes);
+        for (int r = 0; r < nRoutes; r++) routeVersion[r] = ++lastVersion;
+
+        int gain;
+        do {
+            gain = 0;
+            for (auto& routePair : getRoutesPairSequence(nRoutes)) {
+                if (data.shouldStop()) break;
+                int gainIt;
+                do {
+                    gainIt = swapStarIt(solution, routePair.first, routePair.second);
+                    gain += gainIt;
+                } while (gainIt > 0);
+            }
+        } while (gain > 0);
+        return originalTime - solution->time;
+    }
+};
+
+#endif  // TSPRD_INTERSWAPSTAR_H
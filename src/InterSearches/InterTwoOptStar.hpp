@@ -0,0 +1,107 @@
+#ifndef TSPRD_INTERTWOOPTSTAR_H
+#define TSPRD_INTERTWOOPTSTAR_H
+
+#include <vector>
+
+#include "../Data.hpp"
+#include "../Solution.h"
+#include "InterSearch.hpp"
+
+/*
+ * 2-opt*: exchange the tails of two routes, r1(0..i) + r2(j+1..) and r2(0..j) + r1(i+1..)
+ *
+ * the time and the release date of the new routes come from the prefix and suffix data of the routes, and the
+ * routes between r1 and r2 are summarized by `routesBetween`, so each pair of cut points is evaluated in O(1)
+ */
+class InterTwoOptStar final : public InterSearch {
+   private:
+    // time and maximum release date of the prefix route(0..i) and the suffix route(i..end) of a route
+    struct RouteData {
+        std::vector<int> prefixTime, prefixRD, suffixTime, suffixRD;
+
+        void load(const Data& data, const std::vector<int>* route) {
+            const int size = (int)route->size();
+            prefixTime.resize(size), prefixRD.resize(size), suffixTime.resize(size), suffixRD.resize(size);
+
+            prefixTime[0] = prefixRD[0] = 0;
+            for (int i = 1; i < size; i++) {
+                prefixTime[i] = prefixTime[i - 1] + data.timesMatrix[route->at(i - 1)][route->at(i)];
+                prefixRD[i] = std::max(prefixRD[i - 1], data.releaseDates[route->at(i)]);
+            }
+
+            suffixTime[size - 1] = suffixRD[size - 1] = 0;
+            for (int i = size - 2; i >= 0; i--) {
+                suffixTime[i] = suffixTime[i + 1] + data.timesMatrix[route->at(i)][route->at(i + 1)];
+                suffixRD[i] = std::max(suffixRD[i + 1], data.releaseDates[route->at(i)]);
+            }
+        }
+    };
+
+    RouteData d1, d2;  // data of the routes r1 and r2 being searched
+
+    int twoOptStarIt(Solution* s, int r1, int r2) {
+        std::vector<int>* route1 = s->routes[r1];
+        std::vector<int>* route2 = s->routes[r2];
+        d1.load(data, route1);
+        d2.load(data, route2);
+
+        const RoutesBetween between = routesBetween(s, r1, r2);
+        const int originalEnd = s->routeStart[r2] + s->routeTime[r2];
+
+        for (int i = 0; i <= (int)L(route1); i++) {
+            for (int j = 0; j <= (int)L(route2); j++) {
+                if (i == L(route1) && j == L(route2)) continue;  // no change
+
+                // new r1: route1(0..i) + route2(j+1..)
+                const int r1RD = std::max(d1.prefixRD[i], d2.suffixRD[j + 1]);
+                const int r1Time =
+                    d1.prefixTime[i] + data.timesMatrix[route1->at(i)][route2->at(j + 1)] + d2.suffixTime[j + 1];
+
+                // new r2: route2(0..j) + route1(i+1..)
+                const int r2RD = std::max(d2.prefixRD[j], d1.suffixRD[i + 1]);
+                const int r2Time =
+                    d2.prefixTime[j] + data.timesMatrix[route2->at(j)][route1->at(i + 1)] + d1.suffixTime[i + 1];
+
+                const int end = calculateEndingTime(between, r1RD, r1Time, r2RD, r2Time);
+                if (end < originalEnd) {  // perform the movement
+                    std::vector<int> tail1(route1->begin() + i + 1, route1->end());
+                    route1->resize(i + 1);
+                    route1->insert(route1->end(), route2->begin() + j + 1, route2->end());
+                    route2->resize(j + 1);
+                    route2->insert(route2->end(), tail1.begin(), tail1.end());
+
+                    s->routeRD[r1] = r1RD, s->routeTime[r1] = r1Time;
+                    s->routeRD[r2] = r2RD, s->routeTime[r2] = r2Time;
+                    s->updateStartingTimes(r1);
+                    return originalEnd - end;
+                }
+            }
+        }
+
+        return 0;
+    }
+
+   public:
+    explicit InterTwoOptStar(Data& data) : InterSearch(data) {}
+
+    int search(Solution* solution) override {
+        const int originalTime = solution->time;
+        int gain;
+        do {
+            gain = 0;
+            for (auto& routePair : getRoutesPairSequence(solution->routes.size())) {
+                if (data.shouldStop()) break;
+                int gainIt;
+                do {
+                    gainIt = twoOptStarIt(solution, routePair.first, routePair.second);
+                    gain += gainIt;
+                } while (gainIt > 0);
+            }
+        } while (gain > 0);
+
+        solution->removeEmptyRoutes();
+        return originalTime - solution->time;
+    }
+};
+
+#endif  // TSPRD_INTERTWOOPTSTAR_H
@@ -0,0 +1,103 @@
+#ifndef TSPRD_ROUTEMERGE_H
+#define TSPRD_ROUTEMERGE_H
+
+#include <vector>
+
+#include "../Data.hpp"
+#include "../IntraSearches/IntraReinsertion.hpp"
+#include "../IntraSearches/IntraTwoOpt.hpp"
+#include "../Solution.h"
+#include "InterSearch.hpp"
+
+/*
+ * Inverse of the DivideAndSwap: try to join two consecutive routes r and r+1 into a single route, saving one
+ * return to the depot, with the clients of r before the clients of r+1 or the opposite
+ *
+ * if `reorder` is set, the joint route is also improved with 2-opt and reinsertion moves before being evaluated
+ */
+class RouteMerge final : public InterSearch {
+   private:
+    bool reorder;
+    IntraTwoOpt twoOpt;
+    IntraReinsertion reinsertion;
+    std::vector<int> merged, candidate;  // joint route being evaluated and the best one found
+
+    // time of the route with the clients of `a` followed by the clients of `b`
+    int joinTime(Solution* s, int a, int b) {
+        const int lastA = s->routes[a]->at(L(s->routes[a])), firstB = s->routes[b]->at(F(s->routes[b]));
+        return s->routeTime[a] + s->routeTime[b] - data.timesMatrix[lastA][0] - data.timesMatrix[0][firstB] +
+               data.timesMatrix[lastA][firstB];
+    }
+
+    void join(Solution* s, int a, int b, std::vector<int>& route) {
+        route.assign(s->routes[a]->begin(), s->routes[a]->end() - 1);
+        route.insert(route.end(), s->routes[b]->begin() + 1, s->routes[b]->end());
+    }
+
+    bool mergeIt(Solution* s) {
+        for (int r = 0; r + 1 < s->routes.size(); r++) {
+            const int previousEnd = r == 0 ? 0 : s->routeStart[r - 1] + s->routeTime[r - 1];
+            const int originalEnd = s->routeStart[r + 1] + s->routeTime[r + 1];
+            const int rd = std::max(s->routeRD[r], s->routeRD[r + 1]);
+
+            // the joint route can't finish before its release date plus the cheapest of the two orders
+            const int forward = joinTime(s, r, r + 1), backward = joinTime(s, r + 1, r);
+            if (std::max(previousEnd, rd) + std::min(forward, backward) >= originalEnd && !reorder) continue;
+
+            int bestTime = forward;
+            join(s, r, r + 1, candidate);
+            if (backward < forward) {
+                bestTime = backward;
+                join(s, r + 1, r, candidate);
+            }
+
+            if (reorder) {
+                for (auto [a, b] : {std::make_pair(r, r + 1), std::make_pair(r + 1, r)}) {
+                    join(s, a, b, merged);
+                    int time = a == r ? forward : backward;
+                    int gain;
+                    do {
+                        gain = twoOpt.search(&merged);
+                        gain += reinsertion.search(&merged);
+                        time -= gain;
+                    } while (gain > 0);
+
+                    if (time < bestTime) {
+                        bestTime = time;
+                        std::swap(candidate, merged);
+                    }
+                }
+            }
+
+            if (std::max(previousEnd, rd) + bestTime < originalEnd) {  // perform the merge
+                s->routes[r]->swap(candidate);
+                delete s->routes[r + 1];
+                s->routes.erase(s->routes.begin() + r + 1);
+                s->routeRD.erase(s->routeRD.begin() + r + 1);
+                s->routeTime.erase(s->routeTime.begin() + r + 1);
+                s->routeStart.erase(s->routeStart.begin() + r + 1);
+                s->routeRD[r] = rd;
+                s->routeTime[r] = bestTime;
+                s->updateStartingTimes(r);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+   public:
+    explicit RouteMerge(Data& data, bool reorder)
+        : InterSearch(data), reorder(reorder), twoOpt(data.timesMatrix), reinsertion(data.timesMatrix, 1) {}
+
+    int search(Solution* solution) override {
+        int originalTime = solution->time;
+        bool improved;
+        do {
+            improved = mergeIt(solution);
+        } while (improved && !data.shouldStop());
+        return originalTime - solution->time;
+    }
+};
+
+#endif  // TSPRD_ROUTEMERGE_H
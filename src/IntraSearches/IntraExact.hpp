@@ -0,0 +1,114 @@
+#ifndef TSPRD_INTRAEXACT_H
+#define TSPRD_INTRAEXACT_H
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "../Data.hpp"
+#include "IntraSearch.hpp"
+
+/*
+ * Solve the routes with up to `maxClients` clients to optimality with the Held-Karp dynamic programming,
+ * in O(2^n * n^2) for a route with n clients. Longer routes are left unchanged
+ *
+ * the route starts and ends at the depot, so its best order only depends on the set of clients,
+ * and the orders already calculated are kept in a cache by the sorted set of clients
+ */
+class IntraExact final : public IntraSearch {
+   private:
+    static constexpr int MAX_CACHE = 1 << 16;  // the cache is cleared when it reaches this size
+
+    struct ClientsHash {
+        size_t operator()(const std::vector<int>& clients) const {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (int c : clients) hash = (hash ^ (uint64_t)c) * 0x100000001b3ULL;
+            return hash;
+        }
+    };
+
+    const std::vector<std::vector<int>>& timesMatrix;
+    int maxClients;
+
+    struct Solved {
+        std::vector<int> order;  // best order of the clients
+        int time;                // time of the route in this order
+    };
+
+    std::unordered_map<std::vector<int>, Solved, ClientsHash> cache;  // by the sorted set of clients
+    std::vector<int> clients;
+    std::vector<int> cost;    // cost[mask * n + j]: min time leaving the depot, visiting `mask` and ending at j
+    std::vector<int> parent;  // client visited before j in the path of cost[mask * n + j]
+
+    // best order of the clients
+    Solved solve() {
+        const int n = (int)clients.size();
+        const int full = (1 << n) - 1;
+        cost.assign((full + 1) * n, INF);
+        parent.resize((full + 1) * n);
+
+        for (int j = 0; j < n; j++) cost[(1 << j) * n + j] = timesMatrix[0][clients[j]];
+        for (int mask = 1; mask <= full; mask++) {
+            for (int j = 0; j < n; j++) {
+                const int current = cost[mask * n + j];
+                if (!(mask & (1 << j)) || current == INF) continue;
+                for (int k = 0; k < n; k++) {
+                    if (mask & (1 << k)) continue;
+                    const int next = (mask | (1 << k)) * n + k;
+                    const int time = current + timesMatrix[clients[j]][clients[k]];
+                    if (time < cost[next]) {
+                        cost[next] = time;
+                        parent[next] = j;
+                    }
+                }
+            }
+        }
+
+        int best = INF, last = -1;
+        for (int j = 0; j < n; j++) {
+            const int time = cost[full * n + j] + timesMatrix[clients[j]][0];
+            if (time < best) best = time, last = j;
+        }
+
+        std::vector<int> order(n);
+        for (int mask = full, i = n - 1; i >= 0; i--) {
+            order[i] = clients[last];
+            const int previous = parent[mask * n + last];
+            mask ^= 1 << last;
+            last = previous;
+        }
+        return {order, best};
+    }
+
+    int routeTime(const std::vector<int>& route) const {
+        int time = 0;
+        for (int i = 0; i + 1 < (int)route.size(); i++) time += timesMatrix[route[i]][route[i + 1]];
+        return time;
+    }
+
+   public:
+    explicit IntraExact(const std::vector<std::vector<int>>& timesMatrix, int maxClients)
+        : timesMatrix(timesMatrix), maxClients(maxClients) {}
+
+    // whether the route is solved to optimality by this search
+    bool solves(const std::vector<int>* route) const { return (int)L(route) <= maxClients; }
+
+    int search(std::vector<int>* route) override {
+        if (!solves(route) || L(route) < 2) return 0;
+
+        clients.assign(route->begin() + F(route), route->end() - 1);
+        std::sort(clients.begin(), clients.end());
+
+        auto it = cache.find(clients);
+        if (it == cache.end()) {
+            if (cache.size() >= MAX_CACHE) cache.clear();
+            it = cache.emplace(clients, solve()).first;
+        }
+
+        const int gain = routeTime(*route) - it->second.time;
+        if (gain > 0) std::copy(it->second.order.begin(), it->second.order.end(), route->begin() + F(route));
+        return gain;
+    }
+};
+
+#endif  // TSPRD_INTRAEXACT_H
@@ -0,0 +1,120 @@
+#ifndef TSPRD_INTRAOROPT_H
+#define TSPRD_INTRAOROPT_H
+
+#include <cassert>
+
+#include "IntraSearch.hpp"
+
+/*
+ * Or-opt: relocate a segment of 1 to 3 consecutive clients to another position of the same route,
+ * keeping or reversing its orientation
+ *
+ * only the positions where the segment becomes adjacent to one of the closest vertices of its first or last client
+ * are evaluated, so the search is O(n * nbGranular) instead of O(n^2)
+ */
+class IntraOrOpt final : public IntraSearch {
+   private:
+    static constexpr int MAX_SEGMENT = 3;
+
+    const std::vector<std::vector<int>>& timesMatrix;
+    const std::vector<std::vector<int>>& neighbors;
+    bool first;  // whether to use the first improvement strategy
+
+    std::vector<int> position;  // position of each vertex in the route being searched
+
+    struct Move {
+        int gain = 0;
+        int i, k, j;    // move the k clients starting at i to be after the position j
+        bool reversed;  // whether the segment is reversed
+    };
+
+    /*
+     * evaluate both orientations of the segment route[i, i+k-1] inserted between route[j] and route[j+1]
+     * `removeGain` is the gain of removing the segment and `reverseCost` the change in the segment time when reversed
+     */
+    void evaluate(std::vector<int>* route, int i, int k, int j, int removeGain, int reverseCost, Move& best) {
+        if (j < 0 || j > L(route) || (j >= i - 1 && j <= i + k - 1)) return;
+
+        const int a = route->at(j), b = route->at(j + 1);
+        const int segFirst = route->at(i), segLast = route->at(i + k - 1);
+        const int removed = removeGain + timesMatrix[a][b];
+
+        int gain = removed - timesMatrix[a][segFirst] - timesMatrix[segLast][b];
+        if (gain > best.gain) best = {gain, i, k, j, false};
+
+        gain = removed - timesMatrix[a][segLast] - timesMatrix[segFirst][b] - reverseCost;
+        if (gain > best.gain) best = {gain, i, k, j, true};
+    }
+
+    // best move of the segments starting at position i
+    void evaluateAt(std::vector<int>* route, int i, Move& best) {
+        const int last = L(route);
+        int reverseCost = 0;
+        for (int k = 1; k <= MAX_SEGMENT && i + k - 1 <= last; k++) {
+            const int segFirst = route->at(i), segLast = route->at(i + k - 1);
+            if (k > 1) {
+                reverseCost += timesMatrix[segLast][route->at(i + k - 2)] - timesMatrix[route->at(i + k - 2)][segLast];
+            }
+
+            const int prev = route->at(i - 1), next = route->at(i + k);
+            const int removeGain = timesMatrix[prev][segFirst] + timesMatrix[segLast][next] - timesMatrix[prev][next];
+
+            for (int end : {segFirst, segLast}) {
+                for (int v : neighbors[end]) {
+                    if (v == 0) {  // the segment can be adjacent to the depot at the start or the end of the route
+                        evaluate(route, i, k, 0, removeGain, reverseCost, best);
+                        evaluate(route, i, k, last, removeGain, reverseCost, best);
+                        continue;
+                    }
+                    const int p = position[v];
+                    if (p < 1 || p > last || route->at(p) != v) continue;  // not in this route
+                    evaluate(route, i, k, p - 1, removeGain, reverseCost, best);
+                    evaluate(route, i, k, p, removeGain, reverseCost, best);
+                }
+            }
+        }
+    }
+
+    void perform(std::vector<int>* route, const Move& move) {
+        int start;  // position of the segment after the move
+        if (move.i > move.j) {
+            rotate(route->begin() + move.j + 1, route->begin() + move.i, route->begin() + move.i + move.k);
+            start = move.j + 1;
+        } else {
+            rotate(route->begin() + move.i, route->begin() + move.i + move.k, route->begin() + move.j + 1);
+            start = move.j - move.k + 1;
+        }
+        if (move.reversed) reverse(route->begin() + start, route->begin() + start + move.k);
+
+        for (int p = std::min(move.i, start); p < std::max(move.i, start) + move.k; p++) position[route->at(p)] = p;
+    }
+
+    void loadPositions(std::vector<int>* route) {
+        for (int p = F(route); p <= L(route); p++) position[route->at(p)] = p;
+    }
+
+   public:
+    explicit IntraOrOpt(const std::vector<std::vector<int>>& timesMatrix,
+                        const std::vector<std::vector<int>>& neighbors, bool first = false)
+        : timesMatrix(timesMatrix), neighbors(neighbors), first(first), position(timesMatrix.size(), -1) {}
+
+    int search(std::vector<int>* route) override {
+        loadPositions(route);
+
+        if (first) {
+            return firstImprovement((int)L(route), [&](int i) {
+                Move move;
+                evaluateAt(route, i, move);
+                if (move.gain > 0) perform(route, move);
+                return move.gain;
+            });
+        }
+
+        Move best;
+        for (int i = F(route); i <= L(route); i++) evaluateAt(route, i, best);
+        if (best.gain > 0) perform(route, best);
+        return best.gain;
+    }
+};
+
+#endif  // TSPRD_INTRAOROPT_H
@@ -5,14 +5,47 @@
 
 #include "IntraSearch.hpp"
 
-class IntraReinsertion : public IntraSearch {
+class IntraReinsertion final : public IntraSearch {
    private:
     const std::vector<std::vector<int>>& timesMatrix;
     int n;
+    bool first;  // whether to use the first improvement strategy
+
+    // move the n clients starting at position i to be after the position j
+    void reinsert(std::vector<int>* route, int i, int j) {
+        if (i > j) {
+            // rotate vertex backwards
+            rotate(route->begin() + j + 1, route->begin() + i, route->begin() + i + n);
+        } else {
+            // rotate vertex forward
+            rotate(route->begin() + i, route->begin() + i + n, route->begin() + j + 1);
+        }
+    }
+
+    // perform the first improving reinsertion of the clients starting at position i
+    int improveAt(std::vector<int>* route, int i) {
+        int minusFixed =
+            (int)timesMatrix[route->at(i - 1)][route->at(i)] + (int)timesMatrix[route->at(i + n - 1)][route->at(i + n)];
+        int plusFixed = (int)timesMatrix[route->at(i - 1)][route->at(i + n)];
+
+        for (int j = 0; j <= L(route); j++) {
+            if (j >= i - 1 && j <= i + n - 1) continue;
+
+            int minus = minusFixed + (int)timesMatrix[route->at(j)][route->at(j + 1)];
+            int plus = plusFixed + (int)timesMatrix[route->at(j)][route->at(i)] +
+                       (int)timesMatrix[route->at(i + n - 1)][route->at(j + 1)];
+
+            if (minus - plus > 0) {
+                reinsert(route, i, j);
+                return minus - plus;
+            }
+        }
+        return 0;
+    }
 
    public:
-    explicit IntraReinsertion(const std::vector<std::vector<int>>& timesMatrix, int n)
-        : timesMatrix(timesMatrix), n(n) {}
+    explicit IntraReinsertion(const std::vector<std::vector<int>>& timesMatrix, int n, bool first = false)
+        : timesMatrix(timesMatrix), n(n), first(first) {}
 
     /*
      * Tenta realizar a reinserção de um conjunto de n clientes adjacentes em todas as outras posições possíveis
@@ -23,7 +56,9 @@ class IntraReinsertion : public IntraSearch {
      *
      * j representa onde será feita a tentativa de reinserção
      */
-    int search(std::vector<int>* route) {
+    int search(std::vector<int>* route) override {
+        if (first) return firstImprovement((int)L(route) - n + 1, [&](int i) { return improveAt(route, i); });
+
         int bestI, bestJ;
         int bestGain = 0;
 
@@ -48,15 +83,7 @@ class IntraReinsertion : public IntraSearch {
             }
         }
 
-        if (bestGain > 0) {  // perform reinsertion
-            if (bestI > bestJ) {
-                // rotate vertex backwards
-                rotate(route->begin() + bestJ + 1, route->begin() + bestI, route->begin() + bestI + n);
-            } else {
-                // rotate vertex forward
-                rotate(route->begin() + bestI, route->begin() + bestI + n, route->begin() + bestJ + 1);
-            }
-        }
+        if (bestGain > 0) reinsert(route, bestI, bestJ);  // perform reinsertion
         return bestGain;
     }
 };
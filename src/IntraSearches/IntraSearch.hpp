@@ -7,8 +7,32 @@
 #define L(R) ((R)->size() - 2)  // index of last client in a route
 
 class IntraSearch {
+   protected:
+    /*
+     * first improvement strategy
+     * `improveAt(i)` should apply the first improving move found among the moves starting at the i-th client of the
+     * route and return its gain. After an improvement the scan resumes from the same position, and it stops once
+     * all the `nPositions` positions, starting at the first client, are tried in sequence without improvement
+     */
+    template <class ImproveAt>
+    static int firstImprovement(int nPositions, ImproveAt improveAt) {
+        int gain = 0;
+        for (int pos = 0, nFailed = 0; nFailed < nPositions;) {
+            int posGain = improveAt(1 + pos);  // the first client is at index 1
+            if (posGain > 0) {
+                gain += posGain;
+                nFailed = 0;
+            } else {
+                nFailed++;
+                pos = (pos + 1) % nPositions;
+            }
+        }
+        return gain;
+    }
+
    public:
     virtual int search(std::vector<int>* route) = 0;
+    virtual ~IntraSearch() = default;
 };
 
 #endif  // TSPRD_INTRASEARCH_H
@@ -3,9 +3,14 @@
 
 #include <random>
 #include <string>
+#include <variant>
 #include <vector>
 
+#include "../MoveSelector.hpp"
 #include "../Solution.h"
+#include "../Stats.hpp"
+#include "IntraExact.hpp"
+#include "IntraOrOpt.hpp"
 #include "IntraReinsertion.hpp"
 #include "IntraSwap.hpp"
 #include "IntraTwoOpt.hpp"
@@ -13,29 +18,48 @@
 #define F(R) 1                  // index of first client in a route
 #define L(R) ((R)->size() - 2)  // index of last client in a route
 
+/*
+ * A move is stored by value as one of the known search types, so the driver loop calls it through a switch on the
+ * variant index instead of a virtual call, and each search can be inlined in the loop
+ */
+using IntraMove = std::variant<IntraSwap, IntraReinsertion, IntraTwoOpt, IntraOrOpt, IntraExact>;
+
 class IntraSearchAlgo {
    private:
-    std::vector<IntraSearch*> searches;
-    std::mt19937 generator;
+    const Data& data;
+    std::vector<IntraMove> searches;
+    MoveSelector selector;  // order in which the searches are tried
+    int exact;              // index of the exact search, or -1 if not used
+    std::vector<Stats::Counter*> moveStats;
 
-    void shuffleSearches() { shuffle(searches.begin(), searches.end(), generator); }
+   public:
+    static int searchRoute(IntraMove& move, std::vector<int>* route) {
+        return std::visit([route](auto& search) { return search.search(route); }, move);
+    }
 
-    std::vector<IntraSearch*> parseNames(std::vector<std::string> names,
-                                         const std::vector<std::vector<int>>& timesMatrix) {
-        std::vector<IntraSearch*> searches;
-        for (auto& name : names) {
+    static std::vector<IntraMove> parseNames(const std::vector<std::string>& names, const std::vector<bool>& first,
+                                             const Data& data) {
+        const auto& timesMatrix = data.timesMatrix;
+        std::vector<IntraMove> searches;
+        searches.reserve(names.size());
+        for (int i = 0; i < names.size(); i++) {
+            auto& name = names[i];
             if (name == "swap11") {
-                searches.push_back(new IntraSwap(timesMatrix, 1, 1));
+                searches.emplace_back(std::in_place_type<IntraSwap>, timesMatrix, 1, 1, first[i]);
             } else if (name == "swap12") {
-                searches.push_back(new IntraSwap(timesMatrix, 1, 2));
+                searches.emplace_back(std::in_place_type<IntraSwap>, timesMatrix, 1, 2, first[i]);
             } else if (name == "swap22") {
-                searches.push_back(new IntraSwap(timesMatrix, 2, 2));
+                searches.emplace_back(std::in_place_type<IntraSwap>, timesMatrix, 2, 2, first[i]);
             } else if (name == "reinsertion1") {
-                searches.push_back(new IntraReinsertion(timesMatrix, 1));
+                searches.emplace_back(std::in_place_type<IntraReinsertion>, timesMatrix, 1, first[i]);
             } else if (name == "reinsertion2") {
-                searches.push_back(new IntraReinsertion(timesMatrix, 2));
+                searches.emplace_back(std::in_place_type<IntraReinsertion>, timesMatrix, 2, first[i]);
             } else if (name == "2opt") {
-                searches.push_back(new IntraTwoOpt(timesMatrix));
+                searches.emplace_back(std::in_place_type<IntraTwoOpt>, timesMatrix, first[i]);
+            } else if (name == "oropt") {
+                searches.emplace_back(std::in_place_type<IntraOrOpt>, timesMatrix, data.neighbors, first[i]);
+            } else if (name == "exact") {
+                searches.emplace_back(std::in_place_type<IntraExact>, timesMatrix, data.params.exactSize);
             } else {
                 std::cerr << "Invalid intra-route search name: " << name << std::endl;
                 exit(1);
@@ -45,22 +69,46 @@ class IntraSearchAlgo {
         return searches;
     }
 
-   public:
     explicit IntraSearchAlgo(const Data& data)
-        : searches(parseNames(data.params.intraMoves, data.timesMatrix)), generator(data.generator) {}
+        : data(data),
+          searches(parseNames(data.params.intraMoves, data.params.intraFirst, data)),
+          selector(data.params.intraMoves, data.params.adaptiveMoves, data.generator),
+          exact((int)(std::find(data.params.intraMoves.begin(), data.params.intraMoves.end(), "exact") -
+                      data.params.intraMoves.begin())) {
+        if (exact == searches.size()) exact = -1;
+        if (Stats::enabled()) {
+            for (auto& name : data.params.intraMoves) moveStats.push_back(&Stats::counter("intra." + name));
+        }
+    }
 
     int search(Solution* solution) {
+        STATS_COUNTER(searchStats, "intra");
+        STATS_START(searchStart);
         int oldTime = solution->time;
-        shuffleSearches();
+        selector.reorder();
 
         for (auto& route : solution->routes) {
+            if (data.shouldStop()) break;
+            if (exact != -1 && std::get<IntraExact>(searches[exact]).solves(route)) {  // no other move can improve it
+                selector.start();
+                STATS_START(moveStart);
+                int gain = searchRoute(searches[exact], route);
+                STATS_RECORD(*moveStats[exact], moveStart, gain);
+                selector.finish(exact, gain);
+                continue;
+            }
+
             int whichSearch = 0;
 
-            while (whichSearch < searches.size()) {
-                int gain = searches[whichSearch]->search(route);
+            while (whichSearch < searches.size() && !data.shouldStop()) {
+                selector.start();
+                STATS_START(moveStart);
+                int gain = searchRoute(searches[selector[whichSearch]], route);
+                STATS_RECORD(*moveStats[selector[whichSearch]], moveStart, gain);
+                selector.finish(selector[whichSearch], gain);
 
                 if (gain > 0) {  // reset search order
-                    shuffleSearches();
+                    selector.reorder();
                     whichSearch = 0;
                 } else {
                     whichSearch++;
@@ -69,8 +117,14 @@ class IntraSearchAlgo {
         }
 
         int newTime = solution->update();
+        STATS_RECORD(searchStats, searchStart, oldTime - newTime);
         return oldTime - newTime;
     }
+
+    // start over the move selection, as if the search was constructed with the given generator
+    void reset(const std::mt19937& generator) { selector.reset(generator); }
+
+    void printMoveWeights(std::ostream& out) const { selector.print(out, "intra"); }
 };
 
 #endif  // TSPRD_INTRASEARCHALGO_H
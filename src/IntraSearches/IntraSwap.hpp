@@ -5,10 +5,11 @@
 
 #include "IntraSearch.hpp"
 
-class IntraSwap : public IntraSearch {
+class IntraSwap final : public IntraSearch {
    private:
     const std::vector<std::vector<int>>& timesMatrix;
     int n1, n2;
+    bool first;  // whether to use the first improvement strategy
 
     /*
      * verifica a melhora ao trocar os conjuntos a e b na rota
@@ -50,12 +51,67 @@ class IntraSwap : public IntraSearch {
         return (int)minus - (int)plus;
     }
 
+    // swap the set of size1 elements starting at i with the set of size2 elements starting at j
+    static void performSwap(std::vector<int>* route, int i, int j, int size1, int size2) {
+        if (i > j) {
+            std::swap(i, j);
+            std::swap(size1, size2);
+        }
+
+        std::vector<int> a(route->begin() + i, route->begin() + i + size1);  // primeiro conjunto
+        std::vector<int> b(route->begin() + j, route->begin() + j + size2);  // segundo conjunto
+        int diff = size2 - size1;
+
+        // desloca os elementos que estão entre os conjuntos para suas posições finais
+        if (diff < 0) {
+            for (int x = i + size1; x < j; x++) {
+                route->at(x + diff) = route->at(x);
+            }
+        } else if (diff > 0) {
+            for (int x = j - 1; x >= i + size1; x--) {
+                route->at(x + diff) = route->at(x);
+            }
+        }
+
+        // copia o primeiro conjunto
+        for (int x = 0; x < a.size(); x++) {
+            route->at(j + diff + x) = a[x];
+        }
+
+        // copia o segundo conjunto
+        for (int x = 0; x < b.size(); x++) {
+            route->at(i + x) = b[x];
+        }
+    }
+
+    // perform the first improving swap of the set starting at position i
+    int improveAt(std::vector<int>* route, int i) {
+        if (n1 != n2)
+            for (int j = 1; (j + n2 - 1) < i; j++) {
+                int gain = evaluateSwap(route, j, i, n2, n1);
+                if (gain > 0) {
+                    performSwap(route, i, j, n1, n2);
+                    return gain;
+                }
+            }
+        for (int j = (i + n1 - 1) + 1; (j + n2 - 1) <= L(route); j++) {
+            int gain = evaluateSwap(route, i, j, n1, n2);
+            if (gain > 0) {
+                performSwap(route, i, j, n1, n2);
+                return gain;
+            }
+        }
+        return 0;
+    }
+
    public:
-    explicit IntraSwap(const std::vector<std::vector<int>>& timesMatrix, int n1, int n2)
-        : timesMatrix(timesMatrix), n1(n1), n2(n2) {}
+    explicit IntraSwap(const std::vector<std::vector<int>>& timesMatrix, int n1, int n2, bool first = false)
+        : timesMatrix(timesMatrix), n1(n1), n2(n2), first(first) {}
 
     // realiza o swap entre dois conjuntos de vértices seguidos, de tamanhos n1 e n2
-    int search(std::vector<int>* route) {
+    int search(std::vector<int>* route) override {
+        if (first) return firstImprovement((int)L(route) - n1 + 1, [&](int i) { return improveAt(route, i); });
+
         int bestI, bestJ;  // armazena os indices que representa o melhor swap
         int bestO = 0;     // representa a melhora ao realizar o swap acima
 
@@ -99,35 +155,8 @@ class IntraSwap : public IntraSearch {
         }
 
         if (bestO > 0) {  // se ha uma melhora possível, realiza o swap
-            if (bestI > bestJ) {
-                std::swap(bestI, bestJ);
-                std::swap(n1, n2);
-            }
-
-            std::vector<int> a(route->begin() + bestI, route->begin() + bestI + n1);  // primeiro conjunto
-            std::vector<int> b(route->begin() + bestJ, route->begin() + bestJ + n2);  // segundo conjunto
-            int diff = (int)n2 - (int)n1;
-
-            // desloca os elementos que estão entre os conjuntos para suas posições finais
-            if (diff < 0) {
-                for (int i = bestI + n1; i < bestJ; i++) {
-                    route->at(i + diff) = route->at(i);
-                }
-            } else if (diff > 0) {
-                for (int i = bestJ - 1; i >= bestI + n1; i--) {
-                    route->at(i + diff) = route->at(i);
-                }
-            }
-
-            // copia o primeiro conjunto
-            for (int x = 0; x < a.size(); x++) {
-                route->at(bestJ + diff + x) = a[x];
-            }
-
-            // copia o segundo conjunto
-            for (int x = 0; x < b.size(); x++) {
-                route->at(bestI + x) = b[x];
-            }
+            performSwap(route, bestI, bestJ, n1, n2);
+            if (bestI > bestJ) std::swap(n1, n2);  // the next scans start with the sets in the order just swapped
         }
 
         return bestO;
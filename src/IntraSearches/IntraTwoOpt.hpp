@@ -5,17 +5,40 @@
 
 #include "IntraSearch.hpp"
 
-class IntraTwoOpt : public IntraSearch {
+class IntraTwoOpt final : public IntraSearch {
    private:
     const std::vector<std::vector<int>>& timesMatrix;
+    bool first;  // whether to use the first improvement strategy
+
+    // reverse the first subroute starting at the i-th client whose reversal improves the route
+    int improveAt(std::vector<int>* route, int i) {
+        int minus = (int)timesMatrix[route->at(i - 1)][route->at(i)] + (int)timesMatrix[route->at(i)][route->at(i + 1)];
+        int plus = 0;
+        for (int j = i + 1; j <= L(route); j++) {
+            minus += (int)timesMatrix[route->at(j)][route->at(j + 1)];
+            plus += (int)timesMatrix[route->at(j)][route->at(j - 1)];
+
+            int gain = minus - (plus + (int)timesMatrix[route->at(i - 1)][route->at(j)] +
+                                (int)timesMatrix[route->at(i)][route->at(j + 1)]);
+
+            if (gain > 0) {
+                reverse(route->begin() + i, route->begin() + j + 1);
+                return gain;
+            }
+        }
+        return 0;
+    }
 
    public:
-    explicit IntraTwoOpt(const std::vector<std::vector<int>>& timesMatrix) : timesMatrix(timesMatrix) {}
+    explicit IntraTwoOpt(const std::vector<std::vector<int>>& timesMatrix, bool first = false)
+        : timesMatrix(timesMatrix), first(first) {}
 
     /*
      * tenta inverter a ordem de uma subrota que começa no i-ésimo cliente e termina no j-ésimo cliente
      */
-    int search(std::vector<int>* route) {
+    int search(std::vector<int>* route) override {
+        if (first) return firstImprovement((int)L(route) - 1, [&](int i) { return improveAt(route, i); });
+
         int bestI, bestJ;
         int bestGain = 0;
 
@@ -0,0 +1,119 @@
+#include "LowerBound.h"
+
+#include "AllocationStats.hpp"
+#include "HardwareCounters.hpp"
+#include "Trace.hpp"
+
+LowerBound::LowerBound(const Data& data) : data(data), dist(data.timesMatrix) {}
+
+// Held-Karp bound for the tour through `vertices`, where vertices[0] is the depot
+double LowerBound::oneTreeBound(const std::vector<int>& vertices) const {
+    const int m = (int)vertices.size();
+    auto weight = [&](int i, int j) {
+        return std::min(dist[vertices[i]][vertices[j]], dist[vertices[j]][vertices[i]]);
+    };
+    if (m == 2) return dist[0][vertices[1]] + dist[vertices[1]][0];
+
+    // length of a nearest neighbor tour, used as the target of the subgradient steps
+    double upper = 0;
+    std::vector<bool> visited(m, false);
+    for (int k = 0, i = 0; k < m; k++) {
+        visited[i] = true;
+        int next = 0;
+        for (int j = 1; j < m; j++) {
+            if (!visited[j] && (next == 0 || weight(i, j) < weight(i, next))) next = j;
+        }
+        upper += weight(i, next);
+        i = next;
+    }
+
+    std::vector<double> pi(m, 0.), key(m);
+    std::vector<int> degree(m), parent(m);
+    std::vector<bool> inTree(m);
+    double best = 0., step = 2.;
+    for (int it = 0, notImproved = 0; it < ITERATIONS; it++) {
+        // minimum spanning tree of the clients with Prim
+        std::fill(degree.begin(), degree.end(), 0);
+        std::fill(inTree.begin(), inTree.end(), false);
+        std::fill(key.begin(), key.end(), std::numeric_limits<double>::max());
+        key[1] = 0.;
+        parent[1] = -1;
+        double cost = 0.;
+        for (int k = 1; k < m; k++) {
+            int u = -1;
+            for (int j = 1; j < m; j++) {
+                if (!inTree[j] && (u == -1 || key[j] < key[u])) u = j;
+            }
+            inTree[u] = true;
+            cost += key[u];
+            if (parent[u] != -1) degree[u]++, degree[parent[u]]++;
+            for (int j = 1; j < m; j++) {
+                const double w = weight(u, j) + pi[u] + pi[j];
+                if (!inTree[j] && w < key[j]) key[j] = w, parent[j] = u;
+            }
+        }
+
+        // and the two cheapest edges of the depot
+        int first = -1, second = -1;
+        for (int j = 1; j < m; j++) {
+            const double w = weight(0, j) + pi[j];
+            if (first == -1 || w < weight(0, first) + pi[first]) {
+                second = first, first = j;
+            } else if (second == -1 || w < weight(0, second) + pi[second]) {
+                second = j;
+            }
+        }
+        cost += weight(0, first) + pi[first] + weight(0, second) + pi[second];
+        degree[first]++, degree[second]++;
+        degree[0] = 2;
+
+        double sumPi = 0.;
+        for (double p : pi) sumPi += p;
+        const double bound = cost - 2 * sumPi;
+        if (bound > best + 1e-9) {
+            best = bound;
+            notImproved = 0;
+        } else if (++notImproved == 5) {
+            step /= 2;
+            notImproved = 0;
+        }
+
+        int norm = 0;
+        for (int j = 1; j < m; j++) norm += (degree[j] - 2) * (degree[j] - 2);
+        if (norm == 0) break;  // the 1-tree is a tour, so the bound is optimal
+
+        const double t = step * std::max(upper - bound, 1.) / norm;
+        for (int j = 1; j < m; j++) pi[j] += t * (degree[j] - 2);
+    }
+
+    return best;
+}
+
+int LowerBound::calculate() {
+    TRACE_SCOPE("lowerBound");
+    HW_COUNTERS(hwCounters, "lowerBound");
+    ALLOCATION_PHASE(allocationPhase, "lowerBound");
+    int bound = 0;
+
+    // the route serving each client can't start before its release date
+    for (int i = 1; i < data.V; i++) bound = std::max(bound, data.releaseDates[i] + dist[0][i] + dist[i][0]);
+
+    std::vector<int> releaseDates(data.releaseDates.begin() + 1, data.releaseDates.end());
+    std::sort(releaseDates.begin(), releaseDates.end());
+    releaseDates.erase(std::unique(releaseDates.begin(), releaseDates.end()), releaseDates.end());
+
+    // evenly spaced release dates, including the first and the last
+    const int nThresholds = std::min((int)releaseDates.size(), MAX_THRESHOLDS);
+    std::vector<int> vertices;
+    for (int k = 0; k < nThresholds && !data.shouldStop(); k++) {  // the bound of the thresholds so far is still valid
+        const int t = releaseDates[nThresholds == 1 ? 0 : k * ((int)releaseDates.size() - 1) / (nThresholds - 1)];
+
+        vertices.assign(1, 0);
+        for (int i = 1; i < data.V; i++) {
+            if (data.releaseDates[i] >= t) vertices.push_back(i);
+        }
+        bound = std::max(bound, t + (int)std::ceil(oneTreeBound(vertices) - 1e-6));
+    }
+
+    return bound;
+}
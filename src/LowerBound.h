@@ -0,0 +1,32 @@
+#ifndef TSPRD_LOWERBOUND_H
+#define TSPRD_LOWERBOUND_H
+
+#include "Data.hpp"
+
+/*
+ * Lower bound on the completion time of any solution
+ *
+ * the clients released at time t or later are only visited after t, in one or more routes starting and ending at
+ * the depot, which together are a closed walk from the depot through all of them. So for every release date t
+ *     t + (shortest tour through the depot and the clients with release date >= t)
+ * is a lower bound. The tour length is bounded by the Held-Karp 1-tree relaxation, with subgradient optimization,
+ * on the shortest path times symmetrized by taking the smaller of the two directions
+ */
+class LowerBound {
+   private:
+    static constexpr int MAX_THRESHOLDS = 30;  // maximum number of release dates evaluated with the 1-tree bound
+    static constexpr int ITERATIONS = 60;      // subgradient iterations of each 1-tree bound
+
+    const Data& data;
+    const std::vector<std::vector<int>>& dist;  // shortest path times, the instance times are closed under them
+
+    double oneTreeBound(const std::vector<int>& vertices) const;
+
+   public:
+    explicit LowerBound(const Data& data);
+
+    // if the run is stopped, the thresholds not yet evaluated are skipped and the bound is weaker
+    int calculate();
+};
+
+#endif  // TSPRD_LOWERBOUND_H
@@ -0,0 +1,96 @@
+#ifndef TSPRD_MOVESELECTOR_H
+#define TSPRD_MOVESELECTOR_H
+
+#include "Data.hpp"
+
+/*
+ * Decides the order in which the moves of a local search are tried
+ *
+ * by default the order is a uniform shuffle. In the adaptive mode, each move has a score given by the moving average
+ * of its gain per microsecond of search, and the order is sampled without replacement with probabilities
+ * proportional to the scores, so moves that rarely pay off on the instance are usually tried last
+ */
+class MoveSelector {
+   private:
+    static constexpr double SCORE_DECAY = 0.1;   // weight of the last call in the moving average of the score
+    static constexpr double EXPLORATION = 0.05;  // minimum weight of a move, relative to the best score
+
+    std::vector<std::string> names;
+    std::vector<int> order;  // order in which the moves are tried
+    bool adaptive;
+    std::mt19937 generator;
+
+    std::vector<double> scores;           // moving average of the gain per microsecond of each move
+    std::vector<long long> calls;         // how many times each move was called
+    std::vector<long long> improvements;  // how many calls of each move improved the solution
+    std::chrono::steady_clock::time_point callStart;
+
+   public:
+    MoveSelector(std::vector<std::string> names, bool adaptive, const std::mt19937& generator)
+        : names(std::move(names)), order(this->names.size()), adaptive(adaptive), generator(generator),
+          scores(this->names.size(), 0.), calls(this->names.size(), 0), improvements(this->names.size(), 0) {
+        std::iota(order.begin(), order.end(), 0);
+    }
+
+    int size() const { return (int)order.size(); }
+
+    // start over as a new selector with the given generator
+    void reset(const std::mt19937& newGenerator) {
+        generator = newGenerator;
+        std::iota(order.begin(), order.end(), 0);
+        std::fill(scores.begin(), scores.end(), 0.);
+        std::fill(calls.begin(), calls.end(), 0);
+        std::fill(improvements.begin(), improvements.end(), 0);
+    }
+
+    // the index of the move in the i-th position of the current order
+    int operator[](int i) const { return order[i]; }
+
+    // choose a new order for the moves
+    void reorder() {
+        if (order.empty()) return;
+        if (!adaptive) {
+            shuffle(order.begin(), order.end(), generator);
+            return;
+        }
+
+        const double minWeight = EXPLORATION * *std::max_element(scores.begin(), scores.end()) + 1e-9;
+        std::uniform_real_distribution<double> dist(0., 1.);
+        std::vector<std::pair<double, int>> keys(order.size());
+        for (int m = 0; m < (int)order.size(); m++) {  // keys of the weighted sampling without replacement
+            keys[m] = {std::log(dist(generator)) / (scores[m] + minWeight), m};
+        }
+        std::sort(keys.begin(), keys.end(), std::greater<>());
+        for (int i = 0; i < (int)order.size(); i++) order[i] = keys[i].second;
+    }
+
+    // put the first move in the order at the end, to avoid repeating it
+    void firstToLast() {
+        if (!order.empty()) std::swap(order.front(), order.back());
+    }
+
+    // should be called right before each call of a move
+    void start() {
+        if (adaptive) callStart = std::chrono::steady_clock::now();
+    }
+
+    // should be called right after each call of a move, with the gain obtained
+    void finish(int move, int gain) {
+        if (!adaptive) return;
+
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - callStart).count();
+        scores[move] += SCORE_DECAY * (std::max(gain, 0) / std::max(micros, 1e-3) - scores[move]);
+        calls[move]++;
+        if (gain > 0) improvements[move]++;
+    }
+
+    void print(std::ostream& out, const std::string& kind) const {
+        if (!adaptive) return;
+        for (int m = 0; m < (int)names.size(); m++) {
+            out << "MOVE_WEIGHT " << kind << " " << names[m] << " " << scores[m] << " " << calls[m] << " "
+                << improvements[m] << std::endl;
+        }
+    }
+};
+
+#endif  // TSPRD_MOVESELECTOR_H
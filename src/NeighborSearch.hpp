@@ -1,9 +1,11 @@
 #ifndef TSPRD_NEIGHBORSEARCH_H
 #define TSPRD_NEIGHBORSEARCH_H
 
+#include "HardwareCounters.hpp"
 #include "InterSearches/InterSearchAlgo.hpp"
 #include "IntraSearches/IntraSearchAlgo.hpp"
 #include "Population.h"
+#include "Trace.hpp"
 
 class NeighborSearch {
    private:
@@ -13,6 +15,8 @@ class NeighborSearch {
     InterSearchAlgo interSearch;
 
     int splitNs(Solution* solution) {
+        STATS_COUNTER(splitStats, "splitNs");
+        STATS_START(start);
         Sequence* sequence = solution->toSequence();
         std::set<int> depotVisits;
         int splitTime = Solution::split(depotVisits, data.timesMatrix, data.releaseDates, *sequence);
@@ -24,33 +28,36 @@ class NeighborSearch {
             solution->mirror(&newSolution);
         }
         delete sequence;
+        STATS_RECORD(splitStats, start, gain);
         return gain;
     }
 
-   public:
-    explicit NeighborSearch(Data& data) : data(data), intraSearch(data), interSearch(data) {}
-
-    int educate(Individual& indiv) {
-        const int originalTime = indiv.eval;
-
-        Solution* solution = new Solution(data, indiv.giantTour, nullptr);
-        intraSearch.search(solution);  // make sure all run at least once
-
+    // alternate between the intra, inter and split searches until two consecutive searches do not improve
+    void localSearch(Solution* solution) {
         int which = 1;  // 0: intra   1: inter     2: split
         int nNotImproved = 0;
         int gain;
 
         do {
             switch (which) {
-                case 0:
+                case 0: {
+                    TRACE_SCOPE("education.intra");
+                    HW_COUNTERS(hwCounters, "education.intra");
                     gain = intraSearch.search(solution);
                     break;
-                case 1:
+                }
+                case 1: {
+                    TRACE_SCOPE("education.inter");
+                    HW_COUNTERS(hwCounters, "education.inter");
                     gain = interSearch.search(solution);
                     break;
-                case 2:
+                }
+                case 2: {
+                    TRACE_SCOPE("education.split");
+                    HW_COUNTERS(hwCounters, "education.split");
                     gain = splitNs(solution);
                     break;
+                }
                 default:
                     throw std::runtime_error("Invalid which");
             }
@@ -63,7 +70,34 @@ class NeighborSearch {
 
             which = (which + 1) % 3;
 
-        } while (nNotImproved < 2);
+        } while (nNotImproved < 2 && !data.shouldStop());
+    }
+
+   public:
+    explicit NeighborSearch(Data& data) : data(data), intraSearch(data), interSearch(data) {}
+
+    // start over as a new search over `data` with its generator seeded with `seed`
+    void reseed(unsigned seed) {
+        data.generator.seed(seed);
+        intraSearch.reset(data.generator);
+        interSearch.reset(data.generator);
+    }
+
+    /*
+     * apply the local search to the individual, changing its giant tour
+     * if after the first intra-route search the solution time is bigger than `cutoff`, the search is stopped and
+     * false is returned, since the individual is not expected to survive anyway
+     */
+    bool educate(Individual& indiv, int cutoff = INF) {
+        Solution* solution = new Solution(data, indiv.giantTour, nullptr);
+        {
+            TRACE_SCOPE("education.intra");
+            HW_COUNTERS(hwCounters, "education.intra");
+            intraSearch.search(solution);  // make sure all run at least once
+        }
+
+        const bool complete = solution->time <= cutoff;
+        if (complete) localSearch(solution);
 
         int i = 0;
         for (const std::vector<int>* route : solution->routes) {
@@ -72,10 +106,15 @@ class NeighborSearch {
                 i++;
             }
         }
-        auto improved = originalTime - solution->time;
         delete solution;
 
-        return improved;
+        return complete;
+    }
+
+    // print the scores learned by the adaptive move selection
+    void printMoveWeights(std::ostream& out) const {
+        intraSearch.printMoveWeights(out);
+        interSearch.printMoveWeights(out);
     }
 };
 
@@ -1,28 +1,73 @@
 #include "Population.h"
 
+#include "AllocationStats.hpp"
+#include "HardwareCounters.hpp"
+#include "NeighborSearch.hpp"
+#include "Stats.hpp"
+#include "Trace.hpp"
+
 Population::Population(Data& data, Split& split)
-    : data(data), split(split), individuals(data.params.mu + data.params.lambda + 1), bestSolution(data) {
+    : data(data), split(split), pool(data.params.nThreads), splits(pool.size(), split),
+      // besides the maximum population, there are slots for the 2 * mu individuals created at (re)initialization
+      individualPool(data.N, 3 * data.params.mu + data.params.lambda + 1),
+      individuals(data.params.mu + data.params.lambda + 1), bestSolution(data), generation(0) {
     individuals.resize(0);
+    if (data.params.initEducate) {
+        for (int w = 0; w < pool.size(); w++) {
+            workerSearches.push_back(std::make_unique<NeighborSearch>(workerData.emplace_back(data)));
+        }
+    }
+    if (!data.params.progressFile.empty()) {
+        progress.open(data.params.progressFile, std::ios::app);
+        if (!progress.is_open()) {
+            std::cout << "Not able to open the progress file: " << data.params.progressFile << std::endl;
+            exit(1);
+        }
+    }
 }
 
 Population::~Population() {
-    for (auto indiv : individuals) delete indiv;
+    for (auto indiv : individuals) individualPool.release(indiv);
     individuals.clear();
 }
 
 void Population::initialize() {
-    for (int i = 0; i < 2 * data.params.mu; i++) {
-        auto individual = new Individual(data);
-        split.split(individual);
-        add(individual);
+    TRACE_SCOPE("population.initialize");
+    HW_COUNTERS(hwCounters, "population.initialize");
+    ALLOCATION_PHASE(allocationPhase, "population.initialize");
+    const int n = 2 * data.params.mu;
+
+    // the giant tours and the seeds are drawn sequentially, so the new individuals
+    // do not depend on the number of threads or on the order the tasks are executed
+    std::vector<Individual*> created(n);
+    std::vector<unsigned int> seeds(n);
+    for (int i = 0; i < n; i++) {
+        created[i] = individualPool.acquire();
+        created[i]->randomTour(data.generator);
+        if (data.params.initEducate) seeds[i] = data.generator();
     }
+
+    pool.run(n, [&](int i, int worker) {
+        if (data.params.initEducate) {
+            ALLOCATION_PHASE(allocationPhase, "population.initialize.education");  // the phases are per thread
+            workerSearches[worker]->reseed(seeds[i]);  // each individual is educated with its own RNG
+            workerSearches[worker]->educate(*created[i]);
+        }
+        splits[worker].split(created[i]);
+    });
+
+    // insert in the creation order to keep the population deterministic
+    for (auto* individual : created) add(individual);
 }
 
 bool Population::add(Individual* indiv) {
+    STATS_COUNTER(addStats, "population.add");
+    STATS_START(start);
+    ALLOCATION_PHASE(allocationPhase, "population.add");
     for (auto* indiv2 : individuals) {
         double indivsDistance = distance(indiv, indiv2);
-        indiv->closest.insert({indivsDistance, indiv2});
-        indiv2->closest.insert({indivsDistance, indiv});
+        indiv->addClose(indivsDistance, indiv2);
+        indiv2->addClose(indivsDistance, indiv);
     }
 
     // Find the position for the individual such that the population is ordered
@@ -30,24 +75,40 @@ bool Population::add(Individual* indiv) {
     int position = individuals.size();
     while (position > 0 && indiv->eval < individuals[position - 1]->eval) position--;
     individuals.emplace(individuals.begin() + position, indiv);
+    tourHashes[indiv->tourHash]++;
+    solutionHashes[indiv->solutionHash]++;
 
     if (indiv->eval < bestSolution.eval) {
-        bestSolution = *indiv;
+        // improvement over the previous best, 0 for the first solution
+        [[maybe_unused]] const int gain = bestSolution.eval == INF ? 0 : bestSolution.eval - indiv->eval;
+        bestSolution.copySolution(*indiv);
         int time =
             std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - data.startTime)
                 .count();
         searchProgress.push_back({time, indiv->eval});
+        if (progress.is_open()) {
+            progress << R"({"time":)" << time << R"(,"generation":)" << generation << R"(,"eval":)" << indiv->eval
+                     << R"(,"populationSize":)" << individuals.size() << "}" << std::endl;
+        }
+        STATS_RECORD(addStats, start, gain);
         return true;
     }
 
+    STATS_RECORD(addStats, start, 0);
     return false;
 }
 
 void Population::survivorsSelection(int nSurvivors) {
+    STATS_COUNTER(selectionStats, "population.survivorsSelection");
+    STATS_START(start);
+    TRACE_SCOPE("population.survivorsSelection");
+    HW_COUNTERS(hwCounters, "population.survivorsSelection");
+    ALLOCATION_PHASE(allocationPhase, "population.survivorsSelection");
     if (nSurvivors == -1) nSurvivors = data.params.mu;
     while (individuals.size() > nSurvivors) {
         removeWorst();
     }
+    STATS_RECORD(selectionStats, start, 0);
 }
 
 void Population::removeWorst() {
@@ -68,14 +129,12 @@ void Population::removeWorst() {
 
     auto* worst = individuals[worstPosition];
     individuals.erase(individuals.begin() + worstPosition);
+    if (--tourHashes[worst->tourHash] == 0) tourHashes.erase(worst->tourHash);
+    if (--solutionHashes[worst->solutionHash] == 0) solutionHashes.erase(worst->solutionHash);
 
-    for (Individual* indiv2 : individuals) {
-        auto it = indiv2->closest.begin();
-        while (it->second != worst) ++it;
-        indiv2->closest.erase(it);
-    }
+    for (Individual* indiv2 : individuals) indiv2->removeClose(worst);
 
-    delete worst;
+    individualPool.release(worst);
 }
 
 void Population::updateBiasedFitness() {
@@ -125,6 +184,10 @@ double Population::nCloseMean(Individual* indiv) {
     return sum / (double)nClose;
 }
 
+bool Population::hasTour(uint64_t tourHash) const { return tourHashes.count(tourHash) > 0; }
+
+bool Population::hasSolution(uint64_t solutionHash) const { return solutionHashes.count(solutionHash) > 0; }
+
 std::pair<Individual*, Individual*> Population::selectParents() {
     updateBiasedFitness();
     std::uniform_int_distribution<int> dist(0, individuals.size() - 1);
@@ -141,6 +204,7 @@ std::pair<Individual*, Individual*> Population::selectParents() {
 }
 
 void Population::diversify() {
+    TRACE_SCOPE("population.diversify");
     survivorsSelection(data.params.mu / 3);  // keeps the mi/3 best solutions we have so far
     initialize();                            // generate 2*mu new individuals
 }
@@ -1,9 +1,16 @@
 #ifndef TSPRD_POPULATION_H
 #define TSPRD_POPULATION_H
 
+#include <deque>
+#include <memory>
+
 #include "Data.hpp"
 #include "Individual.h"
+#include "IndividualPool.hpp"
 #include "Split.h"
+#include "ThreadPool.hpp"
+
+class NeighborSearch;
 
 typedef std::vector<Individual*> Individuals;
 
@@ -11,11 +18,25 @@ class Population {
    private:
     Data& data;
     Split split;
+    ThreadPool pool;            // used to create the new individuals in parallel
+    std::vector<Split> splits;  // one split for each worker of the pool
+
+    // with --initEducate, a copy of the data with its own RNG and a local search over it for each worker of the pool
+    std::deque<Data> workerData;
+    std::vector<std::unique_ptr<NeighborSearch>> workerSearches;
+
+    // how many individuals in the population have each giant tour hash and solution hash
+    std::unordered_map<uint64_t, int> tourHashes;
+    std::unordered_map<uint64_t, int> solutionHashes;
+
+    std::ofstream progress;  // stream of the improvements of the best solution, if --progress is given
 
    public:
+    IndividualPool individualPool;  // every individual in the population is acquired from this pool
     Individuals individuals;
     Individual bestSolution;  // best solution found
     std::vector<std::pair<int, int>> searchProgress;
+    int generation;  // number of offspring generated by the genetic algorithm so far
 
     Population(Data& data, Split& split);
     ~Population();
@@ -29,6 +50,9 @@ class Population {
     double distance(Individual* indiv1, Individual* indiv2);
     double nCloseMean(Individual* indiv);
 
+    bool hasTour(uint64_t tourHash) const;
+    bool hasSolution(uint64_t solutionHash) const;
+
     std::pair<Individual*, Individual*> selectParents();
     void diversify();
 
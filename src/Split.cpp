@@ -1,8 +1,16 @@
 #include "Split.h"
 
+#include "HardwareCounters.hpp"
+#include "Stats.hpp"
+#include "Trace.hpp"
+
 Split::Split(Data& data) : data(data), rdPos(data.N), cumulative(data.N), bestIn(data.N), phi(data.N) {}
 
 void Split::split(Individual* indiv) {
+    STATS_COUNTER(splitStats, "split");
+    STATS_START(start);
+    TRACE_SCOPE("split");
+    HW_COUNTERS(hwCounters, "split");
     load(indiv);
 
     fill(phi.begin(), phi.end(), INF);
@@ -26,6 +34,7 @@ void Split::split(Individual* indiv) {
     }
 
     save(indiv);
+    STATS_RECORD(splitStats, start, 0);
 }
 
 void Split::load(Individual* indiv) {
@@ -64,4 +73,6 @@ void Split::save(Individual* indiv) {
     }
 
     indiv->eval = phi.back();
+    indiv->tourHash = indiv->hashTour();
+    indiv->solutionHash = indiv->hashSolution();
 }
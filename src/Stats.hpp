@@ -0,0 +1,90 @@
+#ifndef TSPRD_STATS_H
+#define TSPRD_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+/*
+ * Counters of calls, improving calls, total gain and time of the moves and the main procedures, printed by --stats
+ *
+ * the counting is only compiled with TSPRD_STATS defined (cmake -DTSPRD_STATS=ON), otherwise the STATS_* macros
+ * expand to nothing. The counters are atomic, since the individuals of the initialization are created in parallel
+ */
+class Stats {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Counter {
+        const std::string name;
+        std::atomic<long long> calls = 0;
+        std::atomic<long long> improving = 0;  // calls with positive gain
+        std::atomic<long long> gain = 0;
+        std::atomic<long long> nanoseconds = 0;
+
+        explicit Counter(std::string name) : name(std::move(name)) {}
+
+        void record(Clock::time_point start, long long callGain) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            calls.fetch_add(1, std::memory_order_relaxed);
+            if (callGain > 0) {
+                improving.fetch_add(1, std::memory_order_relaxed);
+                gain.fetch_add(callGain, std::memory_order_relaxed);
+            }
+            nanoseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+        }
+    };
+
+   private:
+    std::mutex mutex;
+    std::deque<Counter> counters;  // in the order they were created, a deque keeps the references valid
+
+    static Stats& instance() {
+        static Stats stats;
+        return stats;
+    }
+
+   public:
+    static constexpr bool enabled() {
+#ifdef TSPRD_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // the counter with the given name, created on the first call
+    static Counter& counter(const std::string& name) {
+        Stats& stats = instance();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+        for (Counter& c : stats.counters) {
+            if (c.name == name) return c;
+        }
+        return stats.counters.emplace_back(name);
+    }
+
+    // one line per counter: STAT name calls improving gain nanoseconds
+    static void print(std::ostream& out) {
+        Stats& stats = instance();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+        for (const Counter& c : stats.counters) {
+            out << "STAT " << c.name << " " << c.calls << " " << c.improving << " " << c.gain << " " << c.nanoseconds
+                << std::endl;
+        }
+    }
+};
+
+#ifdef TSPRD_STATS
+#define STATS_COUNTER(var, name) static Stats::Counter& var = Stats::counter(name)
+#define STATS_START(start) const Stats::Clock::time_point start = Stats::Clock::now()
+#define STATS_RECORD(counter, start, gain) (counter).record(start, gain)
+#else
+#define STATS_COUNTER(var, name)
+#define STATS_START(start)
+#define STATS_RECORD(counter, start, gain)
+#endif
+
+#endif  // TSPRD_STATS_H
@@ -0,0 +1,95 @@
+#ifndef TSPRD_THREADPOOL_H
+#define TSPRD_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fixed set of worker threads that execute batches of independent tasks
+// the calling thread also works on the batch as the worker 0
+class ThreadPool {
+   private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp;    // signals the workers that a new batch is available
+    std::condition_variable finished;  // signals the caller that all workers finished the batch
+
+    std::function<void(int, int)> job;  // job(task, worker) executed for each task of the batch
+    int nTasks = 0;                     // number of tasks in the current batch
+    std::atomic<int> nextTask = 0;      // next task to be picked by some worker
+    int running = 0;                    // workers still working on the current batch
+    unsigned int batch = 0;             // identifier of the current batch
+    bool stop = false;
+
+    void runTasks(int worker) {
+        for (int task = nextTask++; task < nTasks; task = nextTask++) job(task, worker);
+    }
+
+    void work(int worker) {
+        unsigned int lastBatch = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait(lock, [&] { return stop || batch != lastBatch; });
+                if (stop) return;
+                lastBatch = batch;
+            }
+
+            runTasks(worker);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) finished.notify_one();
+        }
+    }
+
+   public:
+    // nThreads <= 0 uses all the available hardware threads
+    explicit ThreadPool(int nThreads) {
+        if (nThreads <= 0) nThreads = std::max<int>(1, std::thread::hardware_concurrency());
+        for (int w = 1; w < nThreads; w++) workers.emplace_back(&ThreadPool::work, this, w);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wakeUp.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // number of workers, including the calling thread
+    int size() const { return (int)workers.size() + 1; }
+
+    // execute job(task, worker) for each task in [0, n) and wait until all of them finish
+    // tasks are picked in any order, so each job must only write to data owned by its task or its worker
+    void run(int n, const std::function<void(int, int)>& fn) {
+        if (workers.empty()) {
+            for (int task = 0; task < n; task++) fn(task, 0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = fn;
+            nTasks = n;
+            nextTask = 0;
+            running = (int)workers.size();
+            batch++;
+        }
+        wakeUp.notify_all();
+
+        runTasks(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return running == 0; });
+    }
+};
+
+#endif  // TSPRD_THREADPOOL_H
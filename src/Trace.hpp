@@ -0,0 +1,108 @@
+#ifndef TSPRD_TRACE_H
+#define TSPRD_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+/*
+ * Timeline of the phases of the algorithm, written with --trace in the Chrome trace event format, which can be
+ * opened in chrome://tracing or ui.perfetto.dev
+ *
+ * each TRACE_SCOPE records one complete event, from its declaration to the end of the enclosing block, in a ring
+ * buffer that keeps the last CAPACITY events. When the trace is not started a scope only checks a flag
+ */
+class Trace {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    class Scope {
+       private:
+        const char* name;
+        Clock::time_point start;
+
+       public:
+        explicit Scope(const char* name) : name(name) {
+            if (active()) start = Clock::now();
+        }
+        ~Scope() {
+            if (active()) record(name, start, Clock::now());
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+   private:
+    static constexpr uint64_t CAPACITY = 1 << 20;
+
+    struct Event {
+        const char* name;
+        Clock::time_point start, end;
+        int thread;
+    };
+
+    std::atomic<bool> started = false;
+    Clock::time_point origin;
+    std::vector<Event> events;
+    std::atomic<uint64_t> nEvents = 0;  // total recorded, the event i is at events[i % CAPACITY]
+    std::atomic<int> nThreads = 0;
+
+    static Trace& instance() {
+        static Trace trace;
+        return trace;
+    }
+
+    static bool active() { return instance().started.load(std::memory_order_relaxed); }
+
+    // small sequential identifiers of the threads, in the order they record their first event
+    static int threadId() {
+        thread_local const int id = instance().nThreads++;
+        return id;
+    }
+
+    static void record(const char* name, Clock::time_point start, Clock::time_point end) {
+        Trace& trace = instance();
+        const uint64_t i = trace.nEvents.fetch_add(1, std::memory_order_relaxed);
+        trace.events[i % CAPACITY] = {name, start, end, threadId()};
+    }
+
+    static double microseconds(Clock::duration d) {
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / 1000.;
+    }
+
+   public:
+    // start recording, the timestamps are relative to this call
+    static void start() {
+        Trace& trace = instance();
+        trace.events.resize(CAPACITY);
+        trace.origin = Clock::now();
+        trace.started = true;
+    }
+
+    // write the recorded events, oldest first, must be called after the other threads stopped recording
+    static void write(const std::string& file) {
+        Trace& trace = instance();
+        trace.started = false;
+
+        std::ofstream out(file, std::ios::out);
+        out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+        const uint64_t n = trace.nEvents, first = n > CAPACITY ? n - CAPACITY : 0;
+        for (uint64_t i = first; i < n; i++) {
+            const Event& e = trace.events[i % CAPACITY];
+            out << (i > first ? ",\n" : "\n") << R"({"name":")" << e.name << R"(","ph":"X","ts":)"
+                << microseconds(e.start - trace.origin) << ",\"dur\":" << microseconds(e.end - e.start)
+                << ",\"pid\":1,\"tid\":" << e.thread << "}";
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+    }
+};
+
+#define TRACE_CONCAT(a, b) a##b
+#define TRACE_SCOPE_LINE(name, line) const Trace::Scope TRACE_CONCAT(traceScope, line)(name)
+#define TRACE_SCOPE(name) TRACE_SCOPE_LINE(name, __LINE__)
+
+#endif  // TSPRD_TRACE_H
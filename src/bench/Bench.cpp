@@ -0,0 +1,197 @@
+#include <iomanip>
+
+#include "../Data.hpp"
+#include "../Individual.h"
+#include "../InterSearches/InterSearchAlgo.hpp"
+#include "../IntraSearches/IntraSearchAlgo.hpp"
+#include "../Population.h"
+#include "../Solution.h"
+#include "../Split.h"
+
+/*
+ * Microbenchmarks of the kernels of the algorithm, each one timed in isolation on the same fixed-seed random giant
+ * tours, printed as one line per instance and kernel: BENCH instance N kernel ns/op ops/s
+ */
+
+const std::vector<std::string> INTRA_MOVES = {"swap11",       "swap12", "swap22", "reinsertion1",
+                                              "reinsertion2", "2opt",   "oropt",  "exact"};
+const std::vector<std::string> INTER_MOVES = {"relocation", "swap",     "divideAndSwap", "twoOptStar",
+                                              "swapStar",   "merge",    "mergeReorder"};
+
+AlgParams benchParams(unsigned int seed) {
+    return {.mu = 20,
+            .lambda = 40,
+            .nbElite = 8,
+            .nClose = 6,
+            .itNi = 0,
+            .itDiv = 0,
+            .timeLimit = INF,
+            .nThreads = 1,
+            .initEducate = false,
+            .cloneCheck = false,
+            .eduCacheSize = 0,
+            .eduCutoff = -1.0,
+            .nbGranular = 20,
+            .exactSize = 10,
+            .exactSolver = 0,
+            .seed = seed,
+            .intraMoves = INTRA_MOVES,
+            .intraFirst = std::vector<bool>(INTRA_MOVES.size(), false),
+            .interMoves = INTER_MOVES,
+            .adaptiveMoves = false,
+            .stats = false,
+            .traceFile = "",
+            .progressFile = ""};
+}
+
+class Bench {
+   private:
+    const std::string name;
+    Data& data;
+    int repeat;
+    std::vector<Individual> tours;  // random giant tours, already split
+
+    void report(const std::string& kernel, long long nOps, std::chrono::steady_clock::duration elapsed) const {
+        const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / nOps;
+        std::cout << "BENCH " << name << " " << data.N << " " << kernel << " " << std::fixed << std::setprecision(1)
+                  << ns << " " << std::setprecision(0) << 1e9 / ns << std::defaultfloat << std::endl;
+    }
+
+    // run `op` `repeat` times and report the time per each of its `opsPerRun` operations
+    template <class Op>
+    void time(const std::string& kernel, long long opsPerRun, Op op) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++) op();
+        report(kernel, opsPerRun * repeat, std::chrono::steady_clock::now() - start);
+    }
+
+    std::vector<Solution*> solutions() {
+        std::vector<Solution*> solutions;
+        for (auto& tour : tours) solutions.push_back(new Solution(data, tour.giantTour, nullptr));
+        return solutions;
+    }
+
+   public:
+    Bench(std::string name, Data& data, int nTours, int repeat) : name(std::move(name)), data(data), repeat(repeat) {
+        tours.reserve(nTours);
+        Split split(data);
+        for (int i = 0; i < nTours; i++) {
+            tours.emplace_back(data);  // random tour from the data generator
+            split.split(&tours.back());
+        }
+    }
+
+    void split() {
+        Split split(data);
+        time("split", tours.size(), [&] {
+            for (auto& tour : tours) split.split(&tour);
+        });
+    }
+
+    void populationDistance() {
+        Split split(data);
+        Population population(data, split);
+        double sum = 0.;
+        time("population.distance", tours.size(), [&] {
+            for (int i = 0; i < (int)tours.size(); i++) {
+                sum += population.distance(&tours[i], &tours[(i + 1) % tours.size()]);
+            }
+        });
+        if (sum < 0) std::cout << sum;  // keep the distances from being optimized out
+    }
+
+    void solutionUpdate() {
+        auto sols = solutions();
+        time("solution.update", sols.size(), [&] {
+            for (auto* s : sols) s->update();
+        });
+        for (auto* s : sols) delete s;
+    }
+
+    // each operation is a call of the move on one route of the split random tours
+    void intraMoves() {
+        auto moves = IntraSearchAlgo::parseNames(INTRA_MOVES, data.params.intraFirst, data);
+        auto sols = solutions();
+        for (int m = 0; m < (int)moves.size(); m++) {
+            long long nOps = 0;
+            std::chrono::steady_clock::duration elapsed{};
+            for (int r = 0; r < repeat; r++) {
+                std::vector<std::vector<int>> routes;
+                for (auto* s : sols) {
+                    for (auto* route : s->routes) routes.push_back(*route);
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                for (auto& route : routes) IntraSearchAlgo::searchRoute(moves[m], &route);
+                elapsed += std::chrono::steady_clock::now() - start;
+                nOps += routes.size();
+            }
+            report("intra." + INTRA_MOVES[m], nOps, elapsed);
+        }
+        for (auto* s : sols) delete s;
+    }
+
+    // each operation is a full search of the move on one split random tour
+    void interMoves() {
+        auto moves = InterSearchAlgo::parseNames(INTER_MOVES, data);
+        auto sols = solutions();
+        for (int m = 0; m < (int)moves.size(); m++) {
+            std::chrono::steady_clock::duration elapsed{};
+            for (int r = 0; r < repeat; r++) {
+                std::vector<Solution*> copies;
+                for (auto* s : sols) copies.push_back(s->copy());
+
+                const auto start = std::chrono::steady_clock::now();
+                for (auto* s : copies) InterSearchAlgo::searchSolution(moves[m], s);
+                elapsed += std::chrono::steady_clock::now() - start;
+                for (auto* s : copies) delete s;
+            }
+            report("inter." + INTER_MOVES[m], (long long)sols.size() * repeat, elapsed);
+        }
+        for (auto* s : sols) delete s;
+    }
+};
+
+int main(int argc, char** argv) {
+    argparse::ArgumentParser program("tsprd_bench");
+    program.add_argument("-i", "--instances")
+        .help("Instance files")
+        .nargs(argparse::nargs_pattern::any)
+        .default_value(std::vector<std::string>{
+            "instances/Solomon/10/R101_1.dat", "instances/Solomon/25/R101_1.dat", "instances/Solomon/50/R101_1.dat",
+            "instances/Solomon/100/R101_1.dat", "instances/TSPLIB/kroA200_1.dat", "instances/TSPLIB/pcb442_1.dat"});
+    program.add_argument("--tours").help("Number of random giant tours").default_value(100).scan<'i', int>();
+    program.add_argument("--repeat").help("Times each kernel runs on all the tours").default_value(5).scan<'i', int>();
+    program.add_argument("-s", "--seed").help("Seed of the random tours").default_value(1u).scan<'u', unsigned int>();
+
+    try {
+        program.parse_args(argc, argv);
+    } catch (const std::runtime_error& err) {
+        std::cout << "argparse error" << std::endl;
+        std::cout << err.what() << std::endl;
+        exit(1);
+    }
+
+    const int nTours = program.get<int>("--tours");
+    const int repeat = program.get<int>("--repeat");
+    const AlgParams params = benchParams(program.get<unsigned int>("--seed"));
+
+    for (auto& instanceFile : program.get<std::vector<std::string>>("--instances")) {
+        if (!std::filesystem::exists(instanceFile)) {
+            std::cout << "Not able to find this file: " << instanceFile << std::endl;
+            exit(1);
+        }
+        Instance instance(instanceFile);
+        Data data(instance, params);
+
+        std::string name = instanceFile.substr(instanceFile.find_last_of('/') + 1);
+        Bench bench(name.substr(0, name.find_last_of('.')), data, nTours, repeat);
+        bench.split();
+        bench.populationDistance();
+        bench.solutionUpdate();
+        bench.intraMoves();
+        bench.interMoves();
+    }
+
+    return 0;
+}
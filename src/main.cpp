@@ -1,10 +1,26 @@
+#include <csignal>
+
+#include "AllocationStats.hpp"
 #include "Data.hpp"
 #include "GeneticAlgorithm.h"
+#include "HardwareCounters.hpp"
 #include "Instance.h"
 #include "Solution.h"
+#include "Stats.hpp"
+#include "Trace.hpp"
+
+// stop the algorithm, which still writes the best solution found, a second signal terminates the process
+void requestStop(int signal) {
+    Data::stopRequested = true;
+    std::signal(signal, SIG_DFL);
+}
 
 int main(int argc, char** argv) {
     auto [instanceName, outputFile, params] = Data::parseArgs(argc, argv);
+    std::signal(SIGTERM, requestStop);
+    std::signal(SIGINT, requestStop);
+    if (!params.traceFile.empty()) Trace::start();
+    if (params.stats && Stats::enabled()) HardwareCounters::enable();
     auto instance = Instance(instanceName);
     auto data = Data(instance, params);
 
@@ -16,6 +32,25 @@ int main(int argc, char** argv) {
     std::cout << "SOL_TIME " << alg.population.searchProgress.back().first << std::endl;
     std::cout << "OBJ " << alg.population.bestSolution.eval << std::endl;
     std::cout << "SEED " << params.seed << std::endl;
+    std::cout << "PROVEN_OPTIMAL " << alg.provenOptimal << std::endl;
+    std::cout << "LOWER_BOUND " << alg.lowerBound << std::endl;
+    std::cout << "ITERATIONS " << alg.iterations << std::endl;
+    if (alg.educationCache.enabled()) {
+        std::cout << "EDU_CACHE_HITS " << alg.educationCache.hits << std::endl;
+        std::cout << "EDU_CACHE_MISSES " << alg.educationCache.misses << std::endl;
+    }
+    alg.localSearch.printMoveWeights(std::cout);
+    if (params.stats) {
+        if (Stats::enabled()) {
+            Stats::print(std::cout);
+            HardwareCounters::print(std::cout);
+            AllocationStats::print(std::cout);
+        } else {
+            std::cerr << "--stats needs a build with -DTSPRD_STATS=ON" << std::endl;
+        }
+        std::cout << "PEAK_RSS_KB " << AllocationStats::peakRss() << std::endl;
+    }
+    if (!params.traceFile.empty()) Trace::write(params.traceFile);
 
     if (outputFile == "") return 0;
 
@@ -28,6 +63,9 @@ int main(int argc, char** argv) {
     fout << "SOL_TIME " << alg.population.searchProgress.back().first << std::endl;
     fout << "OBJ " << alg.population.bestSolution.eval << std::endl;
     fout << "SEED " << params.seed << std::endl;
+    fout << "PROVEN_OPTIMAL " << alg.provenOptimal << std::endl;
+    fout << "LOWER_BOUND " << alg.lowerBound << std::endl;
+    fout << "ITERATIONS " << alg.iterations << std::endl;
 
     auto s = Solution(data, alg.population.bestSolution.giantTour, nullptr);
     fout << "N_ROUTES " << s.routes.size() << std::endl;